@@ -0,0 +1,55 @@
+# Run in script mode by the mcli_compile_bench_report target.
+#
+# Inputs: CXX, CXX_ID, INCLUDE_DIRS, SOURCE, OBJECTS, RUNS, BUDGET_MS, REPORT
+
+string(REPLACE "|" ";" include_dirs "${INCLUDE_DIRS}")
+string(REPLACE "|" ";" objects "${OBJECTS}")
+
+set(flags)
+if (CXX_ID STREQUAL "MSVC")
+    list(APPEND flags /nologo /std:c++latest /EHsc /Zs)
+    foreach (dir IN LISTS include_dirs)
+        list(APPEND flags "/I${dir}")
+    endforeach()
+else()
+    list(APPEND flags -std=c++23 -fsyntax-only)
+    foreach (dir IN LISTS include_dirs)
+        list(APPEND flags "-I${dir}")
+    endforeach()
+endif()
+
+# Frontend time: syntax-only compile of one generated TU, averaged.
+set(total_us 0)
+foreach (run RANGE 1 ${RUNS})
+    string(TIMESTAMP start "%s%f")
+    execute_process(
+        COMMAND ${CXX} ${flags} ${SOURCE}
+        RESULT_VARIABLE result
+        ERROR_VARIABLE errors
+    )
+    string(TIMESTAMP stop "%s%f")
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "Compiling ${SOURCE} failed:\n${errors}")
+    endif()
+    math(EXPR total_us "${total_us} + ${stop} - ${start}")
+endforeach()
+math(EXPR mean_ms "${total_us} / ${RUNS} / 1000")
+
+# Object size: every generated TU after a full build.
+set(total_bytes 0)
+list(LENGTH objects object_count)
+foreach (object IN LISTS objects)
+    file(SIZE "${object}" bytes)
+    math(EXPR total_bytes "${total_bytes} + ${bytes}")
+endforeach()
+
+set(report "frontend_ms_per_tu=${mean_ms}\n")
+string(APPEND report "object_count=${object_count}\n")
+string(APPEND report "object_bytes_total=${total_bytes}\n")
+file(WRITE "${REPORT}" "${report}")
+message(STATUS "mcli compile bench:\n${report}")
+
+if (BUDGET_MS GREATER 0 AND mean_ms GREATER BUDGET_MS)
+    message(FATAL_ERROR
+        "mcli.hpp frontend time ${mean_ms} ms exceeds budget ${BUDGET_MS} ms")
+endif()
@@ -0,0 +1,141 @@
+#include "mcli/mcli.hpp"
+#include "utils/alloc_counter.hpp"
+#include "utils/bench.hpp"
+
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using bench::utils::allocation_count;
+using bench::utils::do_not_optimize;
+using bench::utils::run;
+using mcli::detail::spec::flag_descriptor;
+
+namespace
+{
+
+constexpr std::size_t option_count = 32;
+constexpr std::size_t iterations = 200'000;
+
+// Generated CLI with many pairwise conflicts spread over the table.
+constexpr std::size_t large_option_count = 30'000;
+constexpr std::size_t large_constraint_count = 300;
+constexpr std::size_t large_iterations = 20'000;
+
+// Time a two-token parse of a large schema with and without constraints.
+// Their ratio is what the perf gate tracks: checking a constraint must
+// cost the words its operands occupy, not the whole option table.
+void run_large_schema()
+{
+    std::vector<std::string> names;
+    auto values = std::make_unique<bool[]>(large_option_count);
+    std::vector<flag_descriptor> descriptors;
+    names.reserve(large_option_count);
+    for (std::size_t i = 0; i < large_option_count; ++i)
+    {
+        names.emplace_back("generated-option-").append(std::to_string(i));
+    }
+    for (std::size_t i = 0; i < large_option_count; ++i)
+    {
+        descriptors.push_back({names[i], "", "Generated option", &values[i]});
+    }
+
+    auto plain = mcli::define().flags(descriptors).build();
+
+    auto builder = mcli::define();
+    builder.flags(descriptors);
+    constexpr std::size_t stride = large_option_count / large_constraint_count;
+    for (std::size_t i = 0; i < large_constraint_count; ++i)
+    {
+        builder.conflicts(names[i * stride], names[i * stride + stride / 2]);
+    }
+    auto constrained = builder.build();
+
+    std::vector<std::string> storage{
+            "bench", "--generated-option-1", "--generated-option-29999"};
+    std::vector<char*> argv;
+    for (auto& arg : storage)
+    {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+    const int argc = static_cast<int>(storage.size());
+
+    const double plain_ns = run("parse_large_schema", large_iterations, 1, [&]
+        {
+            auto result = plain.parse(argc, argv.data());
+            do_not_optimize(result);
+        });
+    const double constrained_ns =
+            run("parse_large_schema_constrained", large_iterations, 1, [&]
+                {
+                    auto result = constrained.parse(argc, argv.data());
+                    do_not_optimize(result);
+                });
+    std::printf("constraint_overhead_ratio %.2f x\n",
+                constrained_ns / plain_ns);
+}
+
+}  // namespace
+
+int main()
+{
+    std::array<bool, option_count> values{};
+
+    auto builder = mcli::define();
+    for (std::size_t i = 0; i < option_count; ++i)
+    {
+        builder.flag()
+                .name("--option-" + std::to_string(i))
+                .help("Benchmark option")
+                .bind(values.at(i));
+    }
+    auto cli = builder.build();
+
+    std::vector<std::string> storage{"bench"};
+    for (std::size_t i = 0; i < option_count; ++i)
+    {
+        storage.push_back("--option-" + std::to_string(i));
+    }
+    std::vector<char*> argv;
+    for (auto& arg : storage)
+    {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+    const int argc = static_cast<int>(storage.size());
+
+    // Applying a matched option: one indirect call through the setter.
+    const auto& schema = cli.schema();
+    run("apply_per_token", iterations, option_count, [&]
+        {
+            for (std::size_t slot = 0; slot < option_count; ++slot)
+            {
+                do_not_optimize(schema.option_at(slot).target({}));
+            }
+        });
+
+    // Whole parse, including lookup and duplicate tracking.
+    run("parse_per_token", iterations / 10, option_count, [&]
+        {
+            auto result = cli.parse(argc, argv.data());
+            do_not_optimize(result);
+        });
+
+    // Heap allocations of one successful parse; tracked by the perf gate.
+    constexpr std::size_t parses = 1000;
+    const auto before = allocation_count();
+    for (std::size_t i = 0; i < parses; ++i)
+    {
+        auto result = cli.parse(argc, argv.data());
+        do_not_optimize(result);
+    }
+    std::printf("allocs_per_parse %zu allocs/op\n",
+                (allocation_count() - before) / parses);
+
+    run_large_schema();
+
+    return 0;
+}
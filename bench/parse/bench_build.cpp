@@ -0,0 +1,68 @@
+#include "mcli/mcli.hpp"
+#include "utils/bench.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using bench::utils::do_not_optimize;
+using bench::utils::run;
+using mcli::detail::spec::flag_descriptor;
+
+namespace
+{
+
+// Size of the generated CLI the bulk API is meant for.
+constexpr std::size_t option_count = 30'000;
+constexpr std::size_t iterations = 10;
+
+}  // namespace
+
+int main()
+{
+    std::vector<std::string> names;
+    std::vector<std::string> abbrs;
+    auto values = std::make_unique<bool[]>(option_count);
+    for (std::size_t i = 0; i < option_count; ++i)
+    {
+        names.emplace_back("generated-option-").append(std::to_string(i));
+        abbrs.emplace_back("g").append(std::to_string(i));
+    }
+
+    std::vector<flag_descriptor> descriptors;
+    for (std::size_t i = 0; i < option_count; ++i)
+    {
+        descriptors.push_back(
+                {names[i], abbrs[i], "Generated option", &values[i]});
+    }
+
+    run("build_bulk_per_option", iterations, option_count, [&]
+        {
+            auto cli = mcli::define().flags(descriptors).build();
+            do_not_optimize(cli);
+        });
+
+    run("build_sequential_per_option", iterations, option_count, [&]
+        {
+            auto builder = mcli::define();
+            for (const auto& desc : descriptors)
+            {
+                builder.flag()
+                        .name(desc.name)
+                        .abbr(desc.abbr)
+                        .help(desc.desc)
+                        .bind(*desc.target);
+            }
+            auto cli = builder.build();
+            do_not_optimize(cli);
+        });
+
+    // Shared help text is stored once, so this stays well below the
+    // per-option cost of separate std::string members.
+    auto cli = mcli::define().flags(descriptors).build();
+    std::printf("schema_bytes_per_option %zu bytes/op\n",
+                cli.schema().memory_bytes() / option_count);
+
+    return 0;
+}
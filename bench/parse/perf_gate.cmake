@@ -0,0 +1,133 @@
+# Run in script mode by the mcli_perf_gate and mcli_perf_baseline targets.
+#
+# Inputs: BENCHMARKS, BASELINE, TIMING_BASELINE, TOLERANCE, CONFIG, REPORT,
+# MODE (check or record)
+#
+# Benchmarks print "<name> <value> <unit>" lines and both baselines store
+# the same lines. BASELINE is committed and holds the machine-independent
+# metrics (allocations, bytes), which must not grow at all. TIMING_BASELINE
+# lives in the build tree and holds times (ns/op) and time ratios (x),
+# which may grow by TOLERANCE percent; without it they are only reported.
+
+if (NOT CONFIG MATCHES "^(Release|RelWithDebInfo)$")
+    message(FATAL_ERROR
+        "mcli perf gate needs an optimized build, got '${CONFIG}'. "
+        "Configure with -DCMAKE_BUILD_TYPE=Release (or RelWithDebInfo).")
+endif()
+
+# math() is integer-only: compare values as hundredths.
+function(to_centi value out)
+    if (value MATCHES "^([0-9]+)\\.([0-9]*)$")
+        set(whole "${CMAKE_MATCH_1}")
+        string(SUBSTRING "${CMAKE_MATCH_2}00" 0 2 fraction)
+    elseif (value MATCHES "^[0-9]+$")
+        set(whole "${value}")
+        set(fraction "00")
+    else()
+        message(FATAL_ERROR "Not a benchmark value: '${value}'")
+    endif()
+    string(REGEX REPLACE "^0(.)" "\\1" fraction "${fraction}")
+    math(EXPR result "${whole} * 100 + ${fraction}")
+    set(${out} ${result} PARENT_SCOPE)
+endfunction()
+
+# Collect "<name> <value> <unit>" lines from every benchmark.
+string(REPLACE "|" ";" benchmarks "${BENCHMARKS}")
+set(results)
+foreach (benchmark IN LISTS benchmarks)
+    execute_process(
+        COMMAND ${benchmark}
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE errors
+    )
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "${benchmark} failed:\n${errors}")
+    endif()
+    string(REPLACE "\n" ";" lines "${output}")
+    foreach (line IN LISTS lines)
+        if (line MATCHES "^[a-z_0-9]+ [0-9.]+ [^ ]+$")
+            list(APPEND results "${line}")
+        endif()
+    endforeach()
+endforeach()
+
+if (MODE STREQUAL "record")
+    set(content "# Parser benchmark baseline, checked by mcli_perf_gate.\n")
+    string(APPEND content
+        "# Machine-independent metrics only; times are kept per build tree.\n")
+    set(timing_content "# Parser benchmark times for this machine.\n")
+    foreach (line IN LISTS results)
+        if (line MATCHES " (ns/op|x)$")
+            string(APPEND timing_content "${line}\n")
+        else()
+            string(APPEND content "${line}\n")
+        endif()
+    endforeach()
+    file(WRITE "${BASELINE}" "${content}")
+    file(WRITE "${TIMING_BASELINE}" "${timing_content}")
+    message(STATUS "Recorded ${BASELINE}:\n${content}")
+    message(STATUS "Recorded ${TIMING_BASELINE}:\n${timing_content}")
+    return()
+endif()
+
+file(STRINGS "${BASELINE}" baseline REGEX "^[^#]")
+set(report)
+if (EXISTS "${TIMING_BASELINE}")
+    file(STRINGS "${TIMING_BASELINE}" timing_baseline REGEX "^[^#]")
+    list(APPEND baseline ${timing_baseline})
+else()
+    string(APPEND report
+        "No ${TIMING_BASELINE}; record one with mcli_perf_baseline to gate "
+        "times.\n")
+    foreach (line IN LISTS results)
+        if (line MATCHES " (ns/op|x)$")
+            string(APPEND report "info ${line}\n")
+        endif()
+    endforeach()
+endif()
+
+set(regressions 0)
+foreach (entry IN LISTS baseline)
+    string(REPLACE " " ";" fields "${entry}")
+    list(GET fields 0 name)
+    list(GET fields 1 expected)
+    list(GET fields 2 unit)
+
+    set(actual)
+    foreach (line IN LISTS results)
+        if (line MATCHES "^${name} ([0-9.]+) ")
+            set(actual "${CMAKE_MATCH_1}")
+        endif()
+    endforeach()
+    if (actual STREQUAL "")
+        string(APPEND report "FAIL ${name}: missing from benchmark output\n")
+        math(EXPR regressions "${regressions} + 1")
+        continue()
+    endif()
+
+    to_centi(${expected} expected_centi)
+    to_centi(${actual} actual_centi)
+    if (unit STREQUAL "ns/op" OR unit STREQUAL "x")
+        math(EXPR limit_centi
+             "${expected_centi} * (100 + ${TOLERANCE}) / 100")
+    else()
+        set(limit_centi ${expected_centi})
+    endif()
+
+    if (actual_centi GREATER limit_centi)
+        set(status "FAIL")
+        math(EXPR regressions "${regressions} + 1")
+    else()
+        set(status "ok  ")
+    endif()
+    string(APPEND report
+        "${status} ${name}: ${actual} ${unit} (baseline ${expected})\n")
+endforeach()
+
+file(WRITE "${REPORT}" "${report}")
+message(STATUS "mcli perf gate (tolerance ${TOLERANCE}%):\n${report}")
+
+if (regressions GREATER 0)
+    message(FATAL_ERROR "${regressions} benchmark(s) regressed past baseline")
+endif()
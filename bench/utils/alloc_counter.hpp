@@ -0,0 +1,19 @@
+#ifndef BENCH_UTILS_ALLOC_COUNTER_HPP_
+#define BENCH_UTILS_ALLOC_COUNTER_HPP_
+
+#include <cstddef>
+
+namespace bench::utils
+{
+
+/**
+ * @brief Number of global operator new calls so far in this process.
+ *
+ * Counted by the replacement allocation functions in alloc_counter.cpp,
+ * which must be linked into the benchmark executable.
+ */
+std::size_t allocation_count() noexcept;
+
+}  // namespace bench::utils
+
+#endif  // BENCH_UTILS_ALLOC_COUNTER_HPP_
@@ -0,0 +1,65 @@
+#ifndef BENCH_UTILS_BENCH_HPP_
+#define BENCH_UTILS_BENCH_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+
+namespace bench::utils
+{
+
+/**
+ * @brief Keep the compiler from optimizing away a computed value.
+ */
+template <typename T>
+inline void do_not_optimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(reinterpret_cast<char const volatile&>(value));
+#endif
+}
+
+/**
+ * @brief Time @p fn over @p iterations runs and print one result line.
+ *
+ * Output format is "<name> <ns_per_op> ns/op", one line per benchmark,
+ * so results can be diffed and parsed by scripts. @p ops_per_iteration
+ * divides the time further, e.g. to report cost per token.
+ */
+template <typename Fn>
+inline double run(std::string_view name,
+                  std::size_t iterations,
+                  std::size_t ops_per_iteration,
+                  Fn&& fn)
+{
+    using clock = std::chrono::steady_clock;
+
+    // Warm up caches and branch predictors.
+    for (std::size_t i = 0; i < iterations / 10 + 1; ++i)
+    {
+        fn();
+    }
+
+    auto start = clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        fn();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(clock::now() -
+                                                            start);
+
+    double ns_per_op = elapsed.count() /
+                       static_cast<double>(iterations * ops_per_iteration);
+    std::printf("%.*s %.2f ns/op\n",
+                static_cast<int>(name.size()),
+                name.data(),
+                ns_per_op);
+    return ns_per_op;
+}
+
+}  // namespace bench::utils
+
+#endif  // BENCH_UTILS_BENCH_HPP_
@@ -0,0 +1,24 @@
+# cmake/precompiled_header.cmake
+#
+# mcli is header-only, so every consumer TU parses mcli.hpp and the standard
+# headers it pulls in. With MCLI_PRECOMPILE_HEADERS=ON the header is
+# precompiled once into mcli_pch, and targets opt in to reuse it:
+#
+#   mcli_target_precompile_headers(my_tool)
+#
+# Reusing a PCH requires the consumer to use the same compile flags as
+# mcli_pch; targets with different flags should not opt in.
+
+if (NOT MCLI_PRECOMPILE_HEADERS)
+    function(mcli_target_precompile_headers target)
+    endfunction()
+    return()
+endif()
+
+add_library(mcli_pch OBJECT ${CMAKE_CURRENT_LIST_DIR}/../src/pch.cpp)
+target_link_libraries(mcli_pch PUBLIC mcli)
+target_precompile_headers(mcli_pch PRIVATE <mcli/mcli.hpp>)
+
+function(mcli_target_precompile_headers target)
+    target_precompile_headers(${target} REUSE_FROM mcli_pch)
+endfunction()
@@ -2,8 +2,17 @@
 #define MCLI_DETAIL_BUILDER_COMMAND_BUILDER_HPP_
 
 #include "mcli/detail/builder/flag_builder.hpp"
+#include "mcli/detail/builder/positional_builder.hpp"
 #include "mcli/detail/command.hpp"
 #include "mcli/detail/parse/command_parser.hpp"
+#include "mcli/detail/spec/constraint_spec.hpp"
+#include "mcli/detail/spec/flag_spec.hpp"
+#include "mcli/detail/utils/parallel.hpp"
+#include "mcli/detail/utils/trace.hpp"
+
+#include <initializer_list>
+#include <span>
+#include <string_view>
 
 namespace mcli::detail::builder
 {
@@ -21,18 +30,103 @@ public:
         return flag_builder{*this, m_cmd};
     }
 
+    /**
+     * @brief Register a batch of flags, e.g. from a generated table.
+     *
+     * Equivalent to calling flag() for each descriptor in order, but large
+     * batches are processed in parallel and validated once at build().
+     * A template only so the thread pool is compiled in translation units
+     * that call it.
+     */
+    template <typename Runner = utils::parallel_runner>
+    command_builder& flags(std::span<const spec::flag_descriptor> flags)
+    {
+        utils::trace_scope trace{"mcli.flags"};
+        m_cmd.add_flags(flags, Runner{});
+        return *this;
+    }
+
+    /**
+     * @brief Start building a positional argument.
+     *
+     * Positionals are assigned in declaration order: required ones first,
+     * then optional ones, then an optional trailing variadic.
+     */
+    positional_builder positional()
+    {
+        return positional_builder{*this, m_cmd};
+    }
+
+    /**
+     * @brief Require @p required whenever @p subject is given.
+     *
+     * Constraints name options by long name or by alias ("-f").
+     */
+    command_builder& requires_option(std::string_view subject,
+                                     std::string_view required)
+    {
+        spec::constraint_spec constraint;
+        constraint.kind = spec::constraint_kind::requires_all;
+        constraint.subject = subject;
+        constraint.operands.emplace_back(required);
+        m_cmd.add_constraint(std::move(constraint));
+        return *this;
+    }
+
+    /**
+     * @brief Reject invocations that give both @p first and @p second.
+     */
+    command_builder& conflicts(std::string_view first, std::string_view second)
+    {
+        return add_group(spec::constraint_kind::conflicts, {first, second});
+    }
+
+    /**
+     * @brief Allow at most one option of the group.
+     */
+    command_builder& mutually_exclusive(
+            std::initializer_list<std::string_view> names)
+    {
+        return add_group(spec::constraint_kind::conflicts, names);
+    }
+
+    /**
+     * @brief Require exactly one option of the group.
+     */
+    command_builder& one_of(std::initializer_list<std::string_view> names)
+    {
+        return add_group(spec::constraint_kind::one_of, names);
+    }
+
     /**
      * @brief Finalize and build the command.
      */
     [[nodiscard]] parse::command_parser build()
     {
+        utils::trace_scope trace{"mcli.build"};
+        m_cmd.freeze();
         return parse::command_parser{std::move(m_cmd)};
     }
 
 private:
+    command_builder& add_group(spec::constraint_kind kind,
+                               std::initializer_list<std::string_view> names)
+    {
+        assert(names.size() >= 2 && "constraint group needs two options");
+
+        spec::constraint_spec constraint;
+        constraint.kind = kind;
+        for (auto name : names)
+        {
+            constraint.operands.emplace_back(name);
+        }
+        m_cmd.add_constraint(std::move(constraint));
+        return *this;
+    }
+
     mcli::detail::command m_cmd;
 };
 
 }  // namespace mcli::detail::builder
 
-#endif  // MCLI_DETAIL_BUILDER_COMMAND_BUILDER_HPP_
\ No newline at end of file
+#endif  // MCLI_DETAIL_BUILDER_COMMAND_BUILDER_HPP_
@@ -4,72 +4,36 @@
 #include "mcli/detail/command.hpp"
 #include "mcli/detail/spec/flag_spec.hpp"
 #include "mcli/detail/spec/option_spec.hpp"
+#include "mcli/detail/spec/option_target.hpp"
+#include "mcli/detail/utils/names.hpp"
+#include "mcli/detail/utils/trace.hpp"
 
 #include <cassert>
+#include <cstdint>
 #include <functional>
 
 namespace mcli::detail::builder
 {
 
-namespace
-{
-
-inline std::string normalize_long_name(std::string_view name)
-{
-    if (name.empty())
-    {
-        return {};
-    }
-
-    if (name.rfind("--", 0) == 0)  // already starts with "--"
-    {
-        return std::string{name};
-    }
-
-    // optional: allow a single '-' and upgrade to '--'?
-    // if (name.front() == '-' && name.size() > 1 && name[1] != '-')
-    //     return std::string{"--"} + std::string{name.substr(1)};
-
-    return std::string{"--"} + std::string{name};
-}
-
-inline std::string normalize_short_name(std::string_view abbr)
-{
-    if (abbr.empty())
-    {
-        return {};
-    }
-
-    if (abbr.rfind('-', 0) == 0)  // already starts with '-'
-    {
-        // optional: reject "--" here since that's a long option shape
-        return std::string{abbr};
-    }
-
-    return std::string{"-"} + std::string{abbr};
-}
-
-}  // namespace
-
 class command_builder;
 
 class flag_builder
 {
 public:
     flag_builder(command_builder& parent, mcli::detail::command& cmd)
-        : m_parent{parent}, m_cmd{cmd}
+        : m_parent{parent}, m_cmd{cmd}, m_trace_start{utils::trace_begin()}
     {
     }
 
     flag_builder& name(std::string_view name)
     {
-        m_flag.name = normalize_long_name(name);
+        m_flag.name = utils::normalize_long_name(name);
         return *this;
     }
 
     flag_builder& abbr(std::string_view abbr)
     {
-        m_flag.abbr = normalize_short_name(abbr);
+        m_flag.abbr = utils::normalize_short_name(abbr);
         return *this;
     }
 
@@ -79,11 +43,31 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Value written to the bound variable before each parse.
+     */
+    flag_builder& default_value(bool value)
+    {
+        m_flag.default_value = value;
+        return *this;
+    }
+
+    /**
+     * @brief Read the flag from @p variable when it is not on the
+     * command line. Accepts 1/0, true/false, yes/no and on/off.
+     */
+    flag_builder& env(std::string_view variable)
+    {
+        m_flag.env.assign(variable.begin(), variable.end());
+        return *this;
+    }
+
     command_builder& bind(bool& target)
     {
         validate();
 
-        m_cmd.get().add_flag(std::move(m_flag), target);
+        m_cmd.get().add_flag(std::move(m_flag), spec::flag_target(target));
+        utils::trace_end("mcli.flag", m_trace_start);
 
         return m_parent.get();
     }
@@ -97,6 +81,7 @@ private:
 
     std::reference_wrapper<command_builder> m_parent;
     std::reference_wrapper<mcli::detail::command> m_cmd;
+    std::uint64_t m_trace_start;  // span from flag() to bind() when tracing
 
     spec::flag_spec m_flag;
 };
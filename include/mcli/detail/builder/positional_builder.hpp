@@ -0,0 +1,107 @@
+#ifndef MCLI_DETAIL_BUILDER_POSITIONAL_BUILDER_HPP_
+#define MCLI_DETAIL_BUILDER_POSITIONAL_BUILDER_HPP_
+
+#include "mcli/detail/command.hpp"
+#include "mcli/detail/parse/arg_range.hpp"
+#include "mcli/detail/spec/option_target.hpp"
+#include "mcli/detail/spec/positional_spec.hpp"
+#include "mcli/detail/utils/trace.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace mcli::detail::builder
+{
+
+class command_builder;
+
+class positional_builder
+{
+public:
+    positional_builder(command_builder& parent, mcli::detail::command& cmd)
+        : m_parent{parent}, m_cmd{cmd}, m_trace_start{utils::trace_begin()}
+    {
+    }
+
+    positional_builder& name(std::string_view name)
+    {
+        m_positional.name = m_cmd.get().intern(name);
+        return *this;
+    }
+
+    positional_builder& help(std::string_view help)
+    {
+        m_positional.desc = m_cmd.get().intern(help);
+        return *this;
+    }
+
+    /**
+     * @brief Allow the argument to be omitted.
+     */
+    positional_builder& optional()
+    {
+        m_positional.kind = spec::positional_kind::optional;
+        return *this;
+    }
+
+    command_builder& bind(std::string& target)
+    {
+        return finish(spec::value_target(target));
+    }
+
+    command_builder& bind(std::string_view& target)
+    {
+        return finish(spec::value_target(target));
+    }
+
+    template <std::integral T>
+        requires(!std::same_as<T, bool>)
+    command_builder& bind(T& target)
+    {
+        return finish(spec::value_target(target));
+    }
+
+    /**
+     * @brief Take all remaining arguments as a lazy view over argv.
+     *
+     * Must be the last positional of the command.
+     */
+    command_builder& bind(parse::arg_range& target)
+    {
+        m_positional.kind = spec::positional_kind::variadic;
+        return finish(spec::option_target{&target, nullptr});
+    }
+
+private:
+    command_builder& finish(spec::option_target target)
+    {
+        validate();
+
+        m_positional.target = target;
+        m_cmd.get().add_positional(m_positional);
+        utils::trace_end("mcli.positional", m_trace_start);
+
+        return m_parent.get();
+    }
+
+    void validate() const
+    {
+        assert(!m_positional.name.empty() &&
+               "positional must have a name before building");
+        assert(!m_positional.desc.empty() &&
+               "positional should have help text");
+    }
+
+    std::reference_wrapper<command_builder> m_parent;
+    std::reference_wrapper<mcli::detail::command> m_cmd;
+    std::uint64_t m_trace_start;  // positional() to bind() span when tracing
+
+    spec::positional_spec m_positional;
+};
+
+}  // namespace mcli::detail::builder
+
+#endif  // MCLI_DETAIL_BUILDER_POSITIONAL_BUILDER_HPP_
@@ -1,11 +1,27 @@
 #ifndef MCLI_DETAIL_COMMAND_HPP_
 #define MCLI_DETAIL_COMMAND_HPP_
 
+#include "mcli/detail/spec/constraint_spec.hpp"
 #include "mcli/detail/spec/flag_spec.hpp"
 #include "mcli/detail/spec/option_spec.hpp"
+#include "mcli/detail/spec/positional_spec.hpp"
+#include "mcli/detail/spec/value_source.hpp"
+#include "mcli/detail/utils/bit_set.hpp"
+#include "mcli/detail/utils/config.hpp"
+#include "mcli/detail/utils/name_index.hpp"
+#include "mcli/detail/utils/names.hpp"
+#include "mcli/detail/utils/string_pool.hpp"
+#include "mcli/detail/utils/trace.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstring>
 #include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace mcli::detail
@@ -16,70 +32,410 @@ class command
 public:
     command() = default;
 
-    void add_flag(spec::flag_spec flag, bool& target)
+    // The name indexes hold views into m_pool; copying would leave them
+    // pointing at the source object.
+    command(const command&) = delete;
+    command& operator=(const command&) = delete;
+    command(command&&) noexcept = default;
+    command& operator=(command&&) noexcept = default;
+
+    void add_flag(spec::flag_spec flag, spec::option_target target)
     {
         spec::option_spec opt;
-        opt.name = std::move(flag.name);
-        opt.abbr = std::move(flag.abbr);
-        opt.desc = std::move(flag.desc);
-        opt.target = &target;
+        opt.name = m_pool.intern(flag.name);
+        opt.abbr = m_pool.intern(flag.abbr);
+        opt.desc = m_pool.intern(flag.desc);
+        opt.target = target;
         opt.kind = spec::option_kind::flag;
         opt.vkind = spec::value_kind::boolean;
 
-        assert_option_unique(opt);
+        const std::size_t slot = m_options.size();
+        m_options.push_back(opt);
 
-        m_options.push_back(std::move(opt));
+        if (flag.default_value.has_value())
+        {
+            add_default(slot, *flag.default_value);
+        }
+        if (!flag.env.empty())
+        {
+            m_env.push_back(spec::env_binding{slot, std::move(flag.env)});
+        }
     }
 
-    std::optional<std::reference_wrapper<spec::option_spec>>
-    find_option_by_name(std::string_view name)
+    /**
+     * @brief Register many flags at once.
+     *
+     * Large batches are normalized and hashed with @p run, then interned
+     * in order; slot order follows @p flags, exactly as if each had been
+     * added with add_flag(). After a large batch, build() also indexes
+     * with @p run, so threading code is only compiled into translation
+     * units that register flags in bulk.
+     */
+    template <typename Runner>
+    void add_flags(std::span<const spec::flag_descriptor> flags,
+                   const Runner& run)
     {
-        for (auto& opt : m_options)
+        struct prepared
         {
-            if (opt.name == name)
+            std::string name;
+            std::string abbr;
+            std::uint64_t name_hash;
+            std::uint64_t abbr_hash;
+        };
+        std::vector<prepared> names(flags.size());
+
+        run(flags.size(),
+            utils::name_index::parallel_threshold,
+            [&](std::size_t begin, std::size_t end)
             {
-                return std::ref(opt);
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    auto& out = names[i];
+                    out.name = utils::normalize_long_name(flags[i].name);
+                    out.abbr = utils::normalize_short_name(flags[i].abbr);
+                    out.name_hash = utils::hash_name(out.name);
+                    out.abbr_hash = utils::hash_name(out.abbr);
+                }
+            });
+        if (flags.size() >= utils::name_index::parallel_threshold)
+        {
+            m_build_indexes = [](command& cmd)
+            { cmd.build_indexes(Runner{}); };
+        }
+
+        m_options.reserve(m_options.size() + flags.size());
+        for (std::size_t i = 0; i < flags.size(); ++i)
+        {
+            const auto& flag = flags[i];
+            assert(!flag.name.empty() && "flag must have a name");
+            assert(!flag.desc.empty() && "flag should have help text");
+            assert(flag.target != nullptr);
+
+            spec::option_spec opt;
+            opt.name = m_pool.intern(names[i].name, names[i].name_hash);
+            opt.abbr = m_pool.intern(names[i].abbr, names[i].abbr_hash);
+            opt.desc = m_pool.intern(flag.desc);
+            opt.target = spec::flag_target(*flag.target);
+            opt.kind = spec::option_kind::flag;
+            opt.vkind = spec::value_kind::boolean;
+            m_options.push_back(opt);
+
+            if (flag.default_value.has_value())
+            {
+                add_default(m_options.size() - 1, *flag.default_value);
             }
         }
-        return std::nullopt;
     }
 
-    std::optional<std::reference_wrapper<spec::option_spec>>
-    find_option_by_abbr(std::string_view abbr)
+    void add_positional(spec::positional_spec positional)
+    {
+        assert_positional_order(positional);
+
+        m_positionals.push_back(positional);
+    }
+
+    [[nodiscard]] utils::string_id intern(std::string_view text)
+    {
+        return m_pool.intern(text);
+    }
+
+    void add_constraint(spec::constraint_spec constraint)
+    {
+        m_constraint_specs.push_back(std::move(constraint));
+    }
+
+    /**
+     * @brief Build the name indexes, validate uniqueness and resolve
+     * declarative constraints into slot bitmasks.
+     *
+     * Called once by command_builder::build(); options must not be added
+     * afterwards.
+     */
+    void freeze()
+    {
+        freeze_indexes();
+        freeze_constraints();
+        freeze_sources();
+    }
+
+    /**
+     * @brief Write every declared default into its bound object.
+     *
+     * Defaults were serialized into one blob when the options were
+     * added, so this is a single pass of small copies.
+     */
+    void apply_defaults() const noexcept
+    {
+        for (const auto& init : m_defaults)
+        {
+            std::memcpy(init.object,
+                        m_default_blob.data() + init.offset,
+                        init.size);
+        }
+    }
+
+    /**
+     * @brief Per-slot value sources before any argument is parsed.
+     */
+    [[nodiscard]] std::span<const spec::value_source> initial_sources()
+            const noexcept
+    {
+        return m_initial_sources;
+    }
+
+    [[nodiscard]] std::span<const spec::env_binding> env_bindings()
+            const noexcept
+    {
+        return m_env;
+    }
+
+    std::optional<std::size_t> find_option_by_name(std::string_view name) const
+    {
+        return m_by_name.find(name);
+    }
+
+    std::optional<std::size_t> find_option_by_abbr(std::string_view abbr) const
+    {
+        return m_by_abbr.find(abbr);
+    }
+
+    [[nodiscard]] std::size_t option_count() const noexcept
+    {
+        return m_options.size();
+    }
+
+    [[nodiscard]] spec::option_spec& option_at(std::size_t slot)
+    {
+        return m_options[slot];
+    }
+
+    [[nodiscard]] const spec::option_spec& option_at(std::size_t slot) const
+    {
+        return m_options[slot];
+    }
+
+    [[nodiscard]] std::size_t positional_count() const noexcept
+    {
+        return m_positionals.size();
+    }
+
+    [[nodiscard]] const spec::positional_spec& positional_at(
+            std::size_t index) const
+    {
+        return m_positionals[index];
+    }
+
+    [[nodiscard]] std::span<const spec::compiled_constraint> constraints()
+            const noexcept
+    {
+        return m_constraints;
+    }
+
+    // Operand slots of @p constraint.
+    [[nodiscard]] utils::sparse_mask constraint_mask(
+            const spec::compiled_constraint& constraint) const noexcept
+    {
+        return utils::sparse_mask{m_constraint_chunks}.subspan(
+                constraint.mask_begin, constraint.mask_size);
+    }
+
+    [[nodiscard]] std::string_view text(utils::string_id id) const
+    {
+        return m_pool.view(id);
+    }
+
+    [[nodiscard]] std::string_view option_name(std::size_t slot) const
+    {
+        return text(m_options[slot].name);
+    }
+
+    [[nodiscard]] std::string_view option_abbr(std::size_t slot) const
+    {
+        return text(m_options[slot].abbr);
+    }
+
+    [[nodiscard]] std::string_view positional_name(std::size_t index) const
+    {
+        return text(m_positionals[index].name);
+    }
+
+    // Heap bytes held by the schema (option table, string pool, indexes
+    // excluded).
+    [[nodiscard]] std::size_t memory_bytes() const noexcept
+    {
+        return m_options.capacity() * sizeof(spec::option_spec) +
+               m_positionals.capacity() * sizeof(spec::positional_spec) +
+               m_pool.memory_bytes();
+    }
+
+private:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void add_default(std::size_t slot, const T& value)
+    {
+        const std::size_t offset = m_default_blob.size();
+        m_default_blob.resize(offset + sizeof(T));
+        std::memcpy(m_default_blob.data() + offset, &value, sizeof(T));
+
+        m_defaults.push_back(
+                spec::default_initializer{m_options[slot].target.object,
+                                          static_cast<std::uint32_t>(offset),
+                                          sizeof(T),
+                                          slot});
+    }
+
+    void freeze_sources()
+    {
+        m_initial_sources.assign(m_options.size(), spec::value_source::none);
+        for (const auto& init : m_defaults)
+        {
+            m_initial_sources[init.slot] = spec::value_source::default_value;
+        }
+    }
+
+    void freeze_indexes()
+    {
+        utils::trace_scope trace{"mcli.build.index"};
+
+        if (m_build_indexes != nullptr)
+        {
+            m_build_indexes(*this);
+        }
+        else
+        {
+            build_indexes(utils::inline_runner{});
+        }
+
+        assert(!m_by_name.duplicate() &&
+               "option name must be unique within command");
+        assert(!m_by_abbr.duplicate() &&
+               "option abbreviation must be unique within command");
+        for (std::size_t slot = 0; slot < m_options.size(); ++slot)
+        {
+            assert(!utils::looks_like_negative_number(option_abbr(slot)) &&
+                   "option abbreviation must not look like a number");
+        }
+    }
+
+    template <typename Runner>
+    void build_indexes(const Runner& run)
     {
-        for (auto& opt : m_options)
+        // Keys are views into the pool, which stops growing here, and
+        // the pool already knows every hash.
+        m_by_name.build(
+                m_options.size(),
+                [this](std::size_t slot) { return option_name(slot); },
+                [this](std::size_t slot)
+                { return m_pool.hash(m_options[slot].name); },
+                run);
+        m_by_abbr.build(
+                m_options.size(),
+                [this](std::size_t slot) { return option_abbr(slot); },
+                [this](std::size_t slot)
+                { return m_pool.hash(m_options[slot].abbr); },
+                run);
+    }
+
+    void freeze_constraints()
+    {
+        utils::trace_scope trace{"mcli.build.constraints"};
+
+        m_constraints.clear();
+        m_constraints.reserve(m_constraint_specs.size());
+        m_constraint_chunks.clear();
+
+        std::vector<std::size_t> slots;
+        for (const auto& spec : m_constraint_specs)
         {
-            if (opt.abbr == abbr)
+            spec::compiled_constraint compiled;
+            compiled.kind = spec.kind;
+            slots.clear();
+
+            // A constraint naming an unknown option is a schema error.
+            // Without asserts it is dropped as a whole: checking only the
+            // options that resolved would change its meaning.
+            bool resolved = true;
+            if (spec.kind == spec::constraint_kind::requires_all)
+            {
+                auto subject = find_constraint_option(spec.subject);
+                resolved = subject.has_value();
+                compiled.subject =
+                        subject.value_or(spec::compiled_constraint::no_subject);
+            }
+
+            for (const auto& operand : spec.operands)
             {
-                return std::ref(opt);
+                auto slot = find_constraint_option(operand);
+                if (!slot.has_value())
+                {
+                    resolved = false;
+                    break;
+                }
+                slots.push_back(*slot);
+            }
+
+            assert(resolved && "constraint refers to an unknown option");
+            if (resolved)
+            {
+                std::sort(slots.begin(), slots.end());
+                compiled.mask_begin =
+                        static_cast<std::uint32_t>(m_constraint_chunks.size());
+                utils::append_sparse_mask(slots, m_constraint_chunks);
+                compiled.mask_size = static_cast<std::uint32_t>(
+                        m_constraint_chunks.size() - compiled.mask_begin);
+                m_constraints.push_back(compiled);
             }
         }
-        return std::nullopt;
     }
 
-    void reset_seen_flags()
+    // Constraints name an option by its long name, with or without the
+    // leading "--", or by its alias ("-f").
+    [[nodiscard]] std::optional<std::size_t> find_constraint_option(
+            std::string_view name) const
     {
-        for (auto& opt : m_options)
+        if (name.size() > 1 && name[0] == '-' && name[1] != '-')
         {
-            opt.seen = false;
+            return find_option_by_abbr(name);
         }
+        return find_option_by_name(utils::normalize_long_name(name));
     }
 
-private:
-    void assert_option_unique(const spec::option_spec& new_opt)
+    // Required positionals come first, then optional ones, then at most
+    // one variadic; otherwise argument assignment would be ambiguous.
+    void assert_positional_order(const spec::positional_spec& new_pos)
     {
-        for (const auto& opt : m_options)
+        if (m_positionals.empty())
         {
-            assert(opt.name != new_opt.name &&
-                   "option name must be unique within command");
-            assert(opt.abbr != new_opt.abbr &&
-                   "option abbreviation must be unique within command");
+            return;
         }
+        const auto last = m_positionals.back().kind;
+        assert(last != spec::positional_kind::variadic &&
+               "variadic positional must be the last positional");
+        assert(!(last == spec::positional_kind::optional &&
+                 new_pos.kind == spec::positional_kind::required) &&
+               "required positional cannot follow an optional one");
+        MCLI_UNUSED(last);
+        MCLI_UNUSED(new_pos);
     }
 
+    utils::string_pool m_pool;
     std::vector<spec::option_spec> m_options;
+    std::vector<spec::positional_spec> m_positionals;
+    std::vector<spec::constraint_spec> m_constraint_specs;
+    std::vector<spec::compiled_constraint> m_constraints;
+    std::vector<utils::mask_chunk> m_constraint_chunks;
+    std::vector<std::byte> m_default_blob;
+    std::vector<spec::default_initializer> m_defaults;
+    std::vector<spec::value_source> m_initial_sources;
+    std::vector<spec::env_binding> m_env;
+    utils::name_index m_by_name;
+    utils::name_index m_by_abbr;
+
+    // Set by add_flags() for large batches: builds the indexes with the
+    // runner the batch was registered with.
+    void (*m_build_indexes)(command&){nullptr};
 };
 
 }  // namespace mcli::detail
 
-#endif  // MCLI_DETAIL_COMMAND_HPP_
\ No newline at end of file
+#endif  // MCLI_DETAIL_COMMAND_HPP_
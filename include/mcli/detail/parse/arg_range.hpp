@@ -0,0 +1,138 @@
+#ifndef MCLI_DETAIL_PARSE_ARG_RANGE_HPP_
+#define MCLI_DETAIL_PARSE_ARG_RANGE_HPP_
+
+#include "mcli/detail/utils/names.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+namespace mcli::detail::parse
+{
+
+/**
+ * @brief Lazy view of the arguments taken by a variadic positional.
+ *
+ * Iterates argv in place, yielding a string_view per argument without
+ * copying. Before the "--" terminator, option tokens (already consumed by
+ * the parser) and empty tokens are skipped; the terminator itself is
+ * skipped and everything after it is yielded verbatim. Memory use is
+ * constant in the number of arguments.
+ *
+ * The range refers to argv and is valid as long as argv is.
+ */
+class arg_range
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        iterator() = default;
+
+        iterator(char* const* pos, char* const* end, char* const* terminator)
+            : m_pos{pos}, m_end{end}, m_terminator{terminator}
+        {
+            skip();
+        }
+
+        std::string_view operator*() const
+        {
+            return std::string_view{*m_pos};
+        }
+
+        iterator& operator++()
+        {
+            ++m_pos;
+            skip();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        /**
+         * @brief Current argument's slot in argv, e.g. to recover its
+         * index for diagnostics.
+         */
+        [[nodiscard]] char* const* position() const noexcept
+        {
+            return m_pos;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.m_pos == rhs.m_pos;
+        }
+
+    private:
+        void skip()
+        {
+            while (m_pos != m_end && !accepts(m_pos))
+            {
+                ++m_pos;
+            }
+        }
+
+        [[nodiscard]] bool accepts(char* const* pos) const
+        {
+            if (pos == m_terminator)
+            {
+                return false;
+            }
+            if (pos > m_terminator)
+            {
+                return true;
+            }
+            std::string_view tok{*pos};
+            return !tok.empty() && !utils::looks_like_option(tok);
+        }
+
+        char* const* m_pos{nullptr};
+        char* const* m_end{nullptr};
+        char* const* m_terminator{nullptr};
+    };
+
+    arg_range() = default;
+
+    /**
+     * @param terminator position of "--" in argv, or @p end if absent.
+     */
+    arg_range(char* const* begin, char* const* end, char* const* terminator)
+        : m_begin{begin}, m_end{end}, m_terminator{terminator}
+    {
+    }
+
+    [[nodiscard]] iterator begin() const
+    {
+        return iterator{m_begin, m_end, m_terminator};
+    }
+
+    [[nodiscard]] iterator end() const
+    {
+        return iterator{m_end, m_end, m_terminator};
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return begin() == end();
+    }
+
+private:
+    char* const* m_begin{nullptr};
+    char* const* m_end{nullptr};
+    char* const* m_terminator{nullptr};
+};
+
+}  // namespace mcli::detail::parse
+
+#endif  // MCLI_DETAIL_PARSE_ARG_RANGE_HPP_
@@ -2,11 +2,24 @@
 #define MCLI_DETAIL_PARSE_COMMAND_PARSER_HPP_
 
 #include "mcli/detail/command.hpp"
+#include "mcli/detail/parse/arg_range.hpp"
+#include "mcli/detail/parse/diagnostic.hpp"
+#include "mcli/detail/parse/diagnostic_renderer.hpp"
 #include "mcli/detail/parse/parse_result.hpp"
+#include "mcli/detail/spec/constraint_spec.hpp"
 #include "mcli/detail/spec/option_spec.hpp"
+#include "mcli/detail/spec/positional_spec.hpp"
+#include "mcli/detail/spec/value_source.hpp"
+#include "mcli/detail/utils/bit_set.hpp"
+#include "mcli/detail/utils/names.hpp"
+#include "mcli/detail/utils/trace.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstdlib>
 #include <span>
+#include <string>
 
 namespace mcli::detail::parse
 {
@@ -14,110 +27,505 @@ namespace mcli::detail::parse
 class command_parser
 {
 public:
-    command_parser(mcli::detail::command&& cmd) : m_cmd{std::move(cmd)} {}
+    command_parser(mcli::detail::command&& cmd) : m_cmd{std::move(cmd)}
+    {
+        m_cmd.apply_defaults();
+    }
 
-    [[nodiscard]] parse_result parse(int argc, char** argv)
+    [[nodiscard]] parse_result parse(int argc,
+                                     char** argv,
+                                     parse_options options = {})
     {
+        utils::trace_scope trace{"mcli.parse"};
+
         parse_result result = parse_result::success();
 
-        reset_seen_flags();
-        parse_range(argc, argv, 1, result);
+        // Rewrite options that declare a default. Options without one
+        // keep whatever the caller (or a previous parse) left in them.
+        m_cmd.apply_defaults();
+        result.set_sources(m_cmd.initial_sources());
+
+        parse_state state{
+                std::span<char*>(argv, static_cast<std::size_t>(argc)),
+                utils::bit_set{m_cmd.option_count()},
+                options,
+                result,
+        };
+
+        bool tokens_ok = false;
+        {
+            utils::trace_scope phase{"mcli.parse.tokens"};
+            tokens_ok = parse_range(state, 1);
+        }
+
+        if (tokens_ok || options.collect_all)
+        {
+            if (!m_cmd.env_bindings().empty())
+            {
+                utils::trace_scope phase{"mcli.parse.env"};
+                apply_environment(state);
+            }
+            {
+                utils::trace_scope phase{"mcli.parse.positionals"};
+                finish_positionals(state);
+            }
+            {
+                utils::trace_scope phase{"mcli.parse.constraints"};
+                check_constraints(state);
+            }
+        }
+
+        if (!result && options.format_message)
+        {
+            utils::trace_scope phase{"mcli.parse.message"};
+            format_message(result);
+        }
 
         return result;
     }
 
+    /**
+     * @brief The frozen command schema, e.g. for rendering diagnostics.
+     */
+    [[nodiscard]] const mcli::detail::command& schema() const noexcept
+    {
+        return m_cmd;
+    }
+
 private:
-    void reset_seen_flags()
+    struct parse_state
+    {
+        std::span<char*> args;
+        utils::bit_set seen;
+        parse_options options;
+        parse_result& result;
+
+        std::size_t next_positional{0};
+        std::size_t variadic_begin{npos};  // argv index of first element
+        std::size_t terminator{npos};      // argv index of "--"
+        std::size_t line_size{0};          // bytes in the joined command
+    };
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // Record a diagnostic; returns true if parsing should continue.
+    static bool report(parse_state& state, const diagnostic& diag)
+    {
+        state.result.add_diagnostic(diag);
+        return state.options.collect_all;
+    }
+
+    static diagnostic make_token_diagnostic(parse_error code,
+                                            std::size_t index,
+                                            std::string_view tok,
+                                            std::size_t offset)
     {
-        m_cmd.reset_seen_flags();
+        diagnostic diag;
+        diag.code = code;
+        diag.token_index = static_cast<std::uint32_t>(index);
+        diag.token = tok;
+        diag.byte_begin = static_cast<std::uint32_t>(offset);
+        diag.byte_end = static_cast<std::uint32_t>(offset + tok.size());
+        return diag;
     }
 
-    void parse_range(int argc,
-                     char** argv,
-                     int start_index,
-                     parse_result& result)
+    bool parse_range(parse_state& state, std::size_t start_index)
     {
-        std::span<char*> args(argv, static_cast<std::size_t>(argc));
-        for (char* arg : args.subspan(static_cast<std::size_t>(start_index)))
+        bool ok = true;
+        std::size_t offset = 0;
+        for (std::size_t index = 0; index < state.args.size(); ++index)
         {
-            std::string_view tok{arg};
-            if (!handle_token(tok, result))
+            std::string_view tok{state.args[index]};
+            if (index >= start_index && !handle_any(state, index, tok, offset))
             {
-                return;
+                ok = false;
+                if (!state.options.collect_all)
+                {
+                    return false;
+                }
             }
+            offset += tok.size() + 1;
         }
+        state.line_size = offset > 0 ? offset - 1 : 0;
+        return ok;
     }
 
-    bool handle_token(std::string_view tok, parse_result& result)
+    // Route a token to option or positional handling. Everything after the
+    // first "--" is positional.
+    bool handle_any(parse_state& state,
+                    std::size_t index,
+                    std::string_view tok,
+                    std::size_t offset)
+    {
+        if (state.terminator == npos)
+        {
+            if (tok == "--")
+            {
+                state.terminator = index;
+                return true;
+            }
+            if (tok.empty())
+            {
+                return true;
+            }
+            if (utils::looks_like_option(tok))
+            {
+                return handle_token(state, index, tok, offset);
+            }
+        }
+        return handle_positional(state, index, tok, offset);
+    }
+
+    bool handle_positional(parse_state& state,
+                           std::size_t index,
+                           std::string_view tok,
+                           std::size_t offset)
+    {
+        using namespace mcli::detail::spec;
+
+        if (state.next_positional >= m_cmd.positional_count())
+        {
+            report(state,
+                   make_token_diagnostic(parse_error::unexpected_positional,
+                                         index,
+                                         tok,
+                                         offset));
+            return false;
+        }
+
+        const auto& positional = m_cmd.positional_at(state.next_positional);
+
+        // The variadic tail is not copied: remember where it starts and
+        // expose it as a view over argv once the whole line is known.
+        if (positional.kind == positional_kind::variadic)
+        {
+            if (state.variadic_begin == npos)
+            {
+                state.variadic_begin = index;
+            }
+            return true;
+        }
+
+        auto position = state.next_positional++;
+        if (!positional.target(tok))
+        {
+            auto diag = make_token_diagnostic(
+                    parse_error::invalid_value, index, tok, offset);
+            diag.positional = static_cast<std::uint32_t>(position);
+            report(state, diag);
+            return false;
+        }
+        return true;
+    }
+
+    // Report a missing required positional and bind the variadic range.
+    bool finish_positionals(parse_state& state)
+    {
+        using namespace mcli::detail::spec;
+
+        const auto count = m_cmd.positional_count();
+        if (count == 0)
+        {
+            return true;
+        }
+
+        const auto& last = m_cmd.positional_at(count - 1);
+        if (last.kind == positional_kind::variadic)
+        {
+            char* const* end = state.args.data() + state.args.size();
+            char* const* begin = state.variadic_begin == npos
+                                         ? end
+                                         : state.args.data() +
+                                                   state.variadic_begin;
+            char* const* terminator = state.terminator == npos
+                                              ? end
+                                              : state.args.data() +
+                                                        state.terminator;
+            *static_cast<arg_range*>(last.target.object) =
+                    arg_range{begin, end, terminator};
+        }
+
+        if (state.next_positional < count &&
+            m_cmd.positional_at(state.next_positional).kind ==
+                    positional_kind::required)
+        {
+            diagnostic diag;
+            diag.code = parse_error::missing_positional;
+            diag.positional = static_cast<std::uint32_t>(state.next_positional);
+            diag.byte_begin = static_cast<std::uint32_t>(state.line_size);
+            diag.byte_end = diag.byte_begin;
+            report(state, diag);
+            return false;
+        }
+        return true;
+    }
+
+    bool handle_token(parse_state& state,
+                      std::size_t index,
+                      std::string_view tok,
+                      std::size_t offset)
     {
         if (tok.empty())
         {
             return true;
         }
 
-        auto option = m_cmd.find_option_by_name(tok);
-        if (!option.has_value())
+        auto slot = m_cmd.find_option_by_name(tok);
+        if (!slot.has_value())
         {
-            option = m_cmd.find_option_by_abbr(tok);
+            slot = m_cmd.find_option_by_abbr(tok);
         }
 
         // Option (flag)
-        if (!option.has_value())
+        if (!slot.has_value())
         {
-            result = parse_result::failure(
-                    parse_error::unknown_option,
-                    "Unknown option: " + std::string{tok});
+#ifndef MCLI_DISABLE_TRACE
+            // Hidden --mcli-trace[=path]; only checked for unknown tokens,
+            // so it costs nothing on the normal path. Already enabled if
+            // mcli::trace_from_args() ran; otherwise tracing starts here
+            // and misses setup and the spans this parse has open.
+            if (utils::g_tracer.enable_from_flag(tok))
+            {
+                return true;
+            }
+#endif
+            auto diag = make_token_diagnostic(
+                    parse_error::unknown_option, index, tok, offset);
+            suggest(diag, tok);
+            report(state, diag);
             return false;
         }
 
-        auto& opt = option->get();
-        if (opt.seen)
+        if (state.seen.test(*slot))
         {
-            result = parse_result::failure(
-                    parse_error::duplicate_option,
-                    "Duplicate option: " + std::string{tok});
+            auto diag = make_token_diagnostic(
+                    parse_error::duplicate_option, index, tok, offset);
+            diag.slot = static_cast<std::uint32_t>(*slot);
+            report(state, diag);
             return false;
         }
 
-        opt.seen = true;
+        state.seen.set(*slot);
 
-        return apply_option(opt, result);
+        if (!m_cmd.option_at(*slot).target({}))
+        {
+            auto diag = make_token_diagnostic(
+                    parse_error::invalid_value, index, tok, offset);
+            diag.slot = static_cast<std::uint32_t>(*slot);
+            report(state, diag);
+            return false;
+        }
+        state.result.set_source(*slot, spec::value_source::command_line);
+        return true;
     }
 
-    static bool apply_option(spec::option_spec& opt, parse_result& /*result*/)
+    // Options not given on the command line fall back to their
+    // environment variable, if one is bound and set.
+    bool apply_environment(parse_state& state) const
     {
-        using namespace mcli::detail::spec;
+        bool ok = true;
+        for (const auto& binding : m_cmd.env_bindings())
+        {
+            if (state.seen.test(binding.slot))
+            {
+                continue;
+            }
+
+            const char* value = std::getenv(binding.variable.c_str());
+            if (value == nullptr)
+            {
+                continue;
+            }
+
+            const auto& opt = m_cmd.option_at(binding.slot);
+            auto target = opt.target;
+            if (opt.vkind == spec::value_kind::boolean)
+            {
+                target.apply = &spec::set_boolean;
+            }
+
+            if (!target(value))
+            {
+                diagnostic diag;
+                diag.code = parse_error::invalid_value;
+                diag.token = value;
+                diag.slot = static_cast<std::uint32_t>(binding.slot);
+                ok = false;
+                if (!report(state, diag))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            // A flag switched off from the environment is absent as far
+            // as constraints go; its source is still recorded.
+            if (opt.vkind != spec::value_kind::boolean ||
+                *static_cast<const bool*>(target.object))
+            {
+                state.seen.set(binding.slot);
+            }
+            state.result.set_source(binding.slot,
+                                    spec::value_source::environment);
+        }
+        return ok;
+    }
+
+    // Fill in the closest long option names for an unknown long token.
+    void suggest(diagnostic& diag, std::string_view tok) const
+    {
+        if (tok.rfind("--", 0) != 0)
+        {
+            return;
+        }
+
+        const std::size_t threshold = std::max<std::size_t>(1, tok.size() / 4);
+        std::array<std::size_t, diagnostic::max_suggestions> distances{};
 
-        switch (opt.kind)
+        for (std::size_t slot = 0; slot < m_cmd.option_count(); ++slot)
         {
-            case option_kind::flag:
+            auto distance =
+                    utils::edit_distance(tok, m_cmd.option_name(slot));
+            if (distance > threshold)
             {
-                apply_flag(opt);
-                return true;
+                continue;
+            }
+
+            // Insert sorted by distance, keeping the closest few.
+            std::size_t pos = diag.suggestion_count;
+            while (pos > 0 && distances[pos - 1] > distance)
+            {
+                if (pos < diagnostic::max_suggestions)
+                {
+                    distances[pos] = distances[pos - 1];
+                    diag.suggestion_slots[pos] =
+                            diag.suggestion_slots[pos - 1];
+                }
+                --pos;
+            }
+            if (pos < diagnostic::max_suggestions)
+            {
+                distances[pos] = distance;
+                diag.suggestion_slots[pos] = static_cast<std::uint32_t>(slot);
+                if (diag.suggestion_count < diagnostic::max_suggestions)
+                {
+                    ++diag.suggestion_count;
+                }
+            }
+        }
+    }
+
+    // Evaluate the constraints compiled at build() against the seen set.
+    // Masks are sparse, so each check ANDs only the words its operands
+    // occupy, independent of the size of the option table. Diagnostics
+    // are only built for the constraints that fail.
+    bool check_constraints(parse_state& state) const
+    {
+        const auto& seen = state.seen;
+        auto constraints = m_cmd.constraints();
+
+        bool ok = true;
+        for (std::size_t index = 0; index < constraints.size(); ++index)
+        {
+            const auto& constraint = constraints[index];
+            const auto mask = m_cmd.constraint_mask(constraint);
+            if (satisfied(seen, constraint, mask))
+            {
+                continue;
             }
-            default:
+
+            ok = false;
+            if (!report(state, violation(state, index, mask)))
             {
-                assert(false && "unknown option kind");
                 return false;
             }
         }
+        return ok;
     }
 
-    // Apply flag behavior.
-    static void apply_flag(spec::option_spec& opt)
+    static bool satisfied(const utils::bit_set& seen,
+                          const spec::compiled_constraint& constraint,
+                          utils::sparse_mask mask) noexcept
     {
-        using namespace mcli::detail::spec;
+        switch (constraint.kind)
+        {
+            case spec::constraint_kind::requires_all:
+                return !seen.test(constraint.subject) || seen.contains(mask);
+            case spec::constraint_kind::conflicts:
+                return seen.count_common(mask) <= 1;
+            case spec::constraint_kind::one_of:
+                return seen.count_common(mask) == 1;
+        }
+        return true;
+    }
+
+    // Describe how constraint @p index failed.
+    diagnostic violation(const parse_state& state,
+                         std::size_t index,
+                         utils::sparse_mask mask) const
+    {
+        const auto& seen = state.seen;
+        const auto& constraint = m_cmd.constraints()[index];
 
-        if (opt.vkind == value_kind::boolean)
+        diagnostic diag;
+        diag.constraint = static_cast<std::uint32_t>(index);
+
+        if (constraint.kind == spec::constraint_kind::requires_all)
         {
-            assert(std::holds_alternative<bool*>(opt.target));
-            if (auto* ptr = std::get_if<bool*>(&opt.target))
+            diag.code = parse_error::missing_required_option;
+            diag.slot = static_cast<std::uint32_t>(constraint.subject);
+            diag.related_slot =
+                    static_cast<std::uint32_t>(seen.find_missing(mask));
+            locate(state, diag.slot, diag);
+        }
+        else if (seen.count_common(mask) > 1)
+        {
+            auto first = seen.find_common(mask);
+            auto second = seen.find_common(mask, first + 1);
+            diag.code = parse_error::conflicting_options;
+            diag.slot = static_cast<std::uint32_t>(first);
+            diag.related_slot = static_cast<std::uint32_t>(second);
+            locate(state, diag.related_slot, diag);
+        }
+        else
+        {
+            diag.code = parse_error::missing_one_of;
+        }
+        return diag;
+    }
+
+    // Find the token that set @p slot. Only runs on the error path; tokens
+    // after "--" are positionals, so a slot set from the environment may
+    // have no token at all.
+    void locate(const parse_state& state,
+                std::uint32_t slot,
+                diagnostic& diag) const
+    {
+        const auto name = m_cmd.option_name(slot);
+        const auto abbr = m_cmd.option_abbr(slot);
+        const auto end = std::min(state.terminator, state.args.size());
+        std::size_t offset = 0;
+        for (std::size_t index = 0; index < end; ++index)
+        {
+            std::string_view tok{state.args[index]};
+            if (index > 0 && (tok == name || (!abbr.empty() && tok == abbr)))
             {
-                assert(*ptr != nullptr);
-                **ptr = true;
+                diag.token_index = static_cast<std::uint32_t>(index);
+                diag.token = tok;
+                diag.byte_begin = static_cast<std::uint32_t>(offset);
+                diag.byte_end = static_cast<std::uint32_t>(offset + tok.size());
+                return;
             }
+            offset += tok.size() + 1;
         }
-        // future: other flag types
+    }
+
+    void format_message(parse_result& result) const
+    {
+        const auto& diag = result.diagnostics().front();
+        std::string message(render_text(diag, m_cmd, {}), '\0');
+        render_text(diag, m_cmd, message);
+        result.set_message(std::move(message));
     }
 
     mcli::detail::command m_cmd;
@@ -125,4 +533,4 @@ private:
 
 }  // namespace mcli::detail::parse
 
-#endif  // MCLI_DETAIL_PARSE_COMMAND_PARSER_HPP_
\ No newline at end of file
+#endif  // MCLI_DETAIL_PARSE_COMMAND_PARSER_HPP_
@@ -0,0 +1,104 @@
+#ifndef MCLI_DETAIL_PARSE_DIAGNOSTIC_HPP_
+#define MCLI_DETAIL_PARSE_DIAGNOSTIC_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace mcli::detail::parse
+{
+
+enum class parse_error
+{
+    none,
+    unknown_option,
+    duplicate_option,
+    invalid_value,
+    missing_required_option,
+    conflicting_options,
+    missing_one_of,
+    missing_positional,
+    unexpected_positional,
+    unknown_command,
+};
+
+/**
+ * @brief Stable machine-readable name of an error code.
+ *
+ * These strings are part of the JSON output and must not change.
+ */
+[[nodiscard]] constexpr std::string_view to_string(parse_error error) noexcept
+{
+    switch (error)
+    {
+        case parse_error::none:
+            return "none";
+        case parse_error::unknown_option:
+            return "unknown_option";
+        case parse_error::duplicate_option:
+            return "duplicate_option";
+        case parse_error::invalid_value:
+            return "invalid_value";
+        case parse_error::missing_required_option:
+            return "missing_required_option";
+        case parse_error::conflicting_options:
+            return "conflicting_options";
+        case parse_error::missing_one_of:
+            return "missing_one_of";
+        case parse_error::missing_positional:
+            return "missing_positional";
+        case parse_error::unexpected_positional:
+            return "unexpected_positional";
+        case parse_error::unknown_command:
+            return "unknown_command";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Structured description of a single parse error.
+ *
+ * Holds indices into argv and the command schema rather than text, so
+ * callers can translate or serialize it without parsing messages. The
+ * token view points into argv and is valid as long as argv is.
+ */
+struct diagnostic
+{
+    static constexpr std::uint32_t npos = UINT32_MAX;
+    static constexpr std::size_t max_suggestions = 3;
+
+    parse_error code{parse_error::none};
+
+    // Offending argv element, npos if the error is not tied to a token.
+    std::uint32_t token_index{npos};
+    std::string_view token;
+
+    // Byte range in the command line formed by joining argv with spaces.
+    std::uint32_t byte_begin{0};
+    std::uint32_t byte_end{0};
+
+    // Option slots involved, npos when not applicable.
+    std::uint32_t slot{npos};
+    std::uint32_t related_slot{npos};
+
+    // Index into command::positional_at(), npos when not applicable.
+    std::uint32_t positional{npos};
+
+    // Index into command::constraints() for constraint violations.
+    std::uint32_t constraint{npos};
+
+    // Option slots whose names resemble an unknown token.
+    std::array<std::uint32_t, max_suggestions> suggestion_slots{};
+    std::uint32_t suggestion_count{0};
+
+    [[nodiscard]] std::span<const std::uint32_t> suggestions() const noexcept
+    {
+        return std::span{suggestion_slots}.first(suggestion_count);
+    }
+};
+
+}  // namespace mcli::detail::parse
+
+#endif  // MCLI_DETAIL_PARSE_DIAGNOSTIC_HPP_
@@ -0,0 +1,405 @@
+#ifndef MCLI_DETAIL_PARSE_DIAGNOSTIC_RENDERER_HPP_
+#define MCLI_DETAIL_PARSE_DIAGNOSTIC_RENDERER_HPP_
+
+#include "mcli/detail/command.hpp"
+#include "mcli/detail/parse/diagnostic.hpp"
+#include "mcli/detail/utils/buffer_writer.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace mcli::detail::parse
+{
+
+/**
+ * @brief Escape sequences wrapped around the parts of a text message.
+ */
+struct text_style
+{
+    std::string_view error;     // message head, e.g. "Unknown option:"
+    std::string_view emphasis;  // offending token or option name
+    std::string_view hint;      // suggestions
+    std::string_view reset;
+};
+
+inline constexpr text_style plain_style{};
+inline constexpr text_style ansi_style{
+        "\x1b[1;31m", "\x1b[1m", "\x1b[32m", "\x1b[0m"};
+
+namespace renderer_detail
+{
+
+inline void write_styled(utils::buffer_writer& out,
+                         std::string_view style,
+                         std::string_view text,
+                         std::string_view reset)
+{
+    if (style.empty())
+    {
+        out.append(text);
+        return;
+    }
+    out.append(style);
+    out.append(text);
+    out.append(reset);
+}
+
+inline void write_text(utils::buffer_writer& out,
+                       const diagnostic& diag,
+                       const command& cmd,
+                       const text_style& style)
+{
+    auto name = [&](std::uint32_t slot) -> std::string_view
+    {
+        return cmd.option_name(slot);
+    };
+    auto head = [&](std::string_view text)
+    {
+        write_styled(out, style.error, text, style.reset);
+    };
+    auto emphasis = [&](std::string_view text)
+    {
+        write_styled(out, style.emphasis, text, style.reset);
+    };
+    auto positional = [&](std::uint32_t index)
+    {
+        out.append(style.emphasis);
+        out.append('<');
+        out.append(cmd.positional_name(index));
+        out.append('>');
+        if (!style.emphasis.empty())
+        {
+            out.append(style.reset);
+        }
+    };
+
+    switch (diag.code)
+    {
+        case parse_error::none:
+            break;
+        case parse_error::unknown_option:
+        {
+            head("Unknown option:");
+            out.append(' ');
+            emphasis(diag.token);
+            if (diag.suggestion_count > 0)
+            {
+                out.append(" (did you mean ");
+                bool first = true;
+                for (auto slot : diag.suggestions())
+                {
+                    if (!first)
+                    {
+                        out.append(", ");
+                    }
+                    first = false;
+                    write_styled(out, style.hint, name(slot), style.reset);
+                }
+                out.append("?)");
+            }
+            break;
+        }
+        case parse_error::duplicate_option:
+        {
+            head("Duplicate option:");
+            out.append(' ');
+            emphasis(diag.token);
+            break;
+        }
+        case parse_error::invalid_value:
+        {
+            if (diag.positional != diagnostic::npos)
+            {
+                head("Invalid value for");
+                out.append(' ');
+                positional(diag.positional);
+                out.append(':');
+            }
+            else if (diag.slot != diagnostic::npos)
+            {
+                head("Invalid value for");
+                out.append(' ');
+                emphasis(name(diag.slot));
+                out.append(':');
+            }
+            else
+            {
+                head("Invalid value:");
+            }
+            out.append(' ');
+            emphasis(diag.token);
+            break;
+        }
+        case parse_error::missing_required_option:
+        {
+            head("Option");
+            out.append(' ');
+            emphasis(name(diag.slot));
+            out.append(" requires ");
+            emphasis(name(diag.related_slot));
+            break;
+        }
+        case parse_error::conflicting_options:
+        {
+            head("Conflicting options:");
+            out.append(' ');
+            emphasis(name(diag.slot));
+            out.append(" and ");
+            emphasis(name(diag.related_slot));
+            break;
+        }
+        case parse_error::missing_one_of:
+        {
+            head("Missing one of:");
+            out.append(' ');
+            const auto mask =
+                    cmd.constraint_mask(cmd.constraints()[diag.constraint]);
+            bool first = true;
+            utils::for_each_bit(
+                    mask,
+                    [&](std::size_t slot)
+                    {
+                        if (!first)
+                        {
+                            out.append(", ");
+                        }
+                        first = false;
+                        emphasis(cmd.option_name(slot));
+                    });
+            break;
+        }
+        case parse_error::missing_positional:
+        {
+            head("Missing argument:");
+            out.append(' ');
+            positional(diag.positional);
+            break;
+        }
+        case parse_error::unexpected_positional:
+        {
+            head("Unexpected argument:");
+            out.append(' ');
+            emphasis(diag.token);
+            break;
+        }
+        case parse_error::unknown_command:
+        {
+            head("Unknown command:");
+            out.append(' ');
+            emphasis(diag.token);
+            break;
+        }
+    }
+}
+
+inline void write_json_string(utils::buffer_writer& out, std::string_view text)
+{
+    constexpr std::string_view hex = "0123456789abcdef";
+
+    out.append('"');
+    for (char c : text)
+    {
+        switch (c)
+        {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\r':
+                out.append("\\r");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            default:
+            {
+                auto byte = static_cast<unsigned char>(c);
+                if (byte < 0x20)
+                {
+                    out.append("\\u00");
+                    out.append(hex[byte >> 4U]);
+                    out.append(hex[byte & 0xFU]);
+                }
+                else
+                {
+                    out.append(c);
+                }
+            }
+        }
+    }
+    out.append('"');
+}
+
+inline void write_json_slot(utils::buffer_writer& out,
+                            const command& cmd,
+                            std::uint32_t slot)
+{
+    if (slot == diagnostic::npos)
+    {
+        out.append("null");
+        return;
+    }
+    write_json_string(out, cmd.option_name(slot));
+}
+
+inline void write_json(utils::buffer_writer& out,
+                       const diagnostic& diag,
+                       const command& cmd)
+{
+    out.append("{\"code\":");
+    write_json_string(out, to_string(diag.code));
+
+    out.append(",\"token_index\":");
+    if (diag.token_index == diagnostic::npos)
+    {
+        out.append("null");
+    }
+    else
+    {
+        out.append_uint(diag.token_index);
+    }
+
+    out.append(",\"token\":");
+    write_json_string(out, diag.token);
+    out.append(",\"begin\":");
+    out.append_uint(diag.byte_begin);
+    out.append(",\"end\":");
+    out.append_uint(diag.byte_end);
+
+    out.append(",\"option\":");
+    write_json_slot(out, cmd, diag.slot);
+    out.append(",\"related_option\":");
+    write_json_slot(out, cmd, diag.related_slot);
+
+    out.append(",\"positional\":");
+    if (diag.positional == diagnostic::npos)
+    {
+        out.append("null");
+    }
+    else
+    {
+        write_json_string(out, cmd.positional_name(diag.positional));
+    }
+
+    // Every option the violated constraint names, e.g. the candidates of
+    // a missing_one_of; empty for other errors.
+    out.append(",\"options\":[");
+    bool first = true;
+    if (diag.constraint != diagnostic::npos)
+    {
+        utils::for_each_bit(
+                cmd.constraint_mask(cmd.constraints()[diag.constraint]),
+                [&](std::size_t slot)
+                {
+                    if (!first)
+                    {
+                        out.append(',');
+                    }
+                    first = false;
+                    write_json_string(out, cmd.option_name(slot));
+                });
+    }
+
+    out.append("],\"suggestions\":[");
+    first = true;
+    for (auto slot : diag.suggestions())
+    {
+        if (!first)
+        {
+            out.append(',');
+        }
+        first = false;
+        write_json_slot(out, cmd, slot);
+    }
+    out.append("]}");
+}
+
+}  // namespace renderer_detail
+
+/**
+ * @brief Render a diagnostic as a one-line message.
+ *
+ * Writes into @p out and returns the number of bytes the full message
+ * needs; if that exceeds out.size() the output is truncated.
+ */
+inline std::size_t render_text(const diagnostic& diag,
+                               const command& cmd,
+                               std::span<char> out,
+                               const text_style& style = plain_style)
+{
+    utils::buffer_writer writer{out};
+    renderer_detail::write_text(writer, diag, cmd, style);
+    return writer.size();
+}
+
+/**
+ * @brief Render a diagnostic as a message colored with ANSI escapes.
+ */
+inline std::size_t render_ansi(const diagnostic& diag,
+                               const command& cmd,
+                               std::span<char> out)
+{
+    return render_text(diag, cmd, out, ansi_style);
+}
+
+/**
+ * @brief Render a diagnostic as a single JSON object.
+ */
+inline std::size_t render_json(const diagnostic& diag,
+                               const command& cmd,
+                               std::span<char> out)
+{
+    utils::buffer_writer writer{out};
+    renderer_detail::write_json(writer, diag, cmd);
+    return writer.size();
+}
+
+/**
+ * @brief Render several diagnostics as newline-separated messages.
+ */
+inline std::size_t render_text(std::span<const diagnostic> diags,
+                               const command& cmd,
+                               std::span<char> out,
+                               const text_style& style = plain_style)
+{
+    utils::buffer_writer writer{out};
+    for (const auto& diag : diags)
+    {
+        renderer_detail::write_text(writer, diag, cmd, style);
+        writer.append('\n');
+    }
+    return writer.size();
+}
+
+/**
+ * @brief Render several diagnostics as a JSON array.
+ */
+inline std::size_t render_json(std::span<const diagnostic> diags,
+                               const command& cmd,
+                               std::span<char> out)
+{
+    utils::buffer_writer writer{out};
+    writer.append('[');
+    bool first = true;
+    for (const auto& diag : diags)
+    {
+        if (!first)
+        {
+            writer.append(',');
+        }
+        first = false;
+        renderer_detail::write_json(writer, diag, cmd);
+    }
+    writer.append(']');
+    return writer.size();
+}
+
+}  // namespace mcli::detail::parse
+
+#endif  // MCLI_DETAIL_PARSE_DIAGNOSTIC_RENDERER_HPP_
@@ -1,17 +1,26 @@
 #ifndef MCLI_DETAIL_PARSE_PARSE_RESULT_HPP_
 #define MCLI_DETAIL_PARSE_PARSE_RESULT_HPP_
 
+#include "mcli/detail/parse/diagnostic.hpp"
+#include "mcli/detail/spec/value_source.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+#include <span>
 #include <string>
+#include <vector>
 
 namespace mcli::detail::parse
 {
 
-enum class parse_error
+struct parse_options
 {
-    none,
-    unknown_option,
-    duplicate_option,
-    invalid_value,
+    // Keep parsing after the first error and report every violation.
+    bool collect_all{false};
+    // Render the first diagnostic into error_message(). Callers that only
+    // consume diagnostics() can turn this off to skip string building.
+    bool format_message{true};
 };
 
 class parse_result
@@ -24,14 +33,6 @@ public:
         return parse_result{};
     }
 
-    static parse_result failure(parse_error error_code, std::string msg)
-    {
-        parse_result res;
-        res.m_error = error_code;
-        res.m_message = std::move(msg);
-        return res;
-    }
-
     explicit operator bool() const noexcept
     {
         return m_error == parse_error::none;
@@ -47,11 +48,71 @@ public:
         return m_message;
     }
 
+    /**
+     * @brief All diagnostics in the order they were detected.
+     */
+    [[nodiscard]] std::span<const diagnostic> diagnostics() const noexcept
+    {
+        return m_diagnostics;
+    }
+
+    void add_diagnostic(const diagnostic& diag)
+    {
+        if (m_error == parse_error::none)
+        {
+            m_error = diag.code;
+        }
+        m_diagnostics.push_back(diag);
+    }
+
+    void set_message(std::string msg)
+    {
+        m_message = std::move(msg);
+    }
+
+    /**
+     * @brief Where each option's value came from, indexed by slot.
+     */
+    [[nodiscard]] std::span<const spec::value_source> sources() const noexcept
+    {
+        return m_sources;
+    }
+
+    [[nodiscard]] spec::value_source source(std::size_t slot) const
+    {
+        assert(slot < m_sources.size());
+        return m_sources[slot];
+    }
+
+    /**
+     * @brief True if the option was given explicitly rather than left at
+     * its default.
+     */
+    [[nodiscard]] bool was_set(std::size_t slot) const
+    {
+        const auto from = source(slot);
+        return from != spec::value_source::none &&
+               from != spec::value_source::default_value;
+    }
+
+    void set_sources(std::span<const spec::value_source> initial)
+    {
+        m_sources.assign(initial.begin(), initial.end());
+    }
+
+    void set_source(std::size_t slot, spec::value_source source)
+    {
+        assert(slot < m_sources.size());
+        m_sources[slot] = source;
+    }
+
 private:
     parse_error m_error{parse_error::none};
     std::string m_message;
+    std::vector<diagnostic> m_diagnostics;
+    std::vector<spec::value_source> m_sources;
 };
 
 }  // namespace mcli::detail::parse
 
-#endif  // MCLI_DETAIL_PARSE_PARSE_RESULT_HPP_
\ No newline at end of file
+#endif  // MCLI_DETAIL_PARSE_PARSE_RESULT_HPP_
@@ -0,0 +1,404 @@
+#ifndef MCLI_DETAIL_REGISTRY_SCHEMA_REGISTRY_HPP_
+#define MCLI_DETAIL_REGISTRY_SCHEMA_REGISTRY_HPP_
+
+#include "mcli/detail/command.hpp"
+#include "mcli/detail/parse/command_parser.hpp"
+#include "mcli/detail/parse/diagnostic.hpp"
+#include "mcli/detail/parse/parse_result.hpp"
+#include "mcli/detail/utils/hash.hpp"
+#include "mcli/detail/utils/name_index.hpp"
+#include "mcli/detail/utils/trace.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mcli::detail::registry
+{
+
+class registered_schema;
+
+/**
+ * @brief A parse result together with the lock of the schema it parsed.
+ *
+ * While @c lock is held no other parse of that schema can overwrite the
+ * bound variables, so the caller can read them consistently.
+ */
+struct locked_parse
+{
+    // Keeps the locked schema alive; declared first so it outlives the lock.
+    std::shared_ptr<const registered_schema> schema;
+    std::unique_lock<std::mutex> lock;  // not owned if nothing was parsed
+    parse::parse_result result;
+};
+
+/**
+ * @brief One published version of a named command.
+ *
+ * Immutable apart from parsing. Parses of the same schema take the same
+ * lock, since they write the same bound variables; different schemas
+ * never share one. parse() releases the lock on return, so reading the
+ * bound variables afterwards races with other parses of the schema;
+ * callers that parse one schema from several threads use parse_locked()
+ * or serialize parse-and-read themselves.
+ */
+class registered_schema
+{
+public:
+    registered_schema(std::string name,
+                      std::uint64_t version,
+                      parse::command_parser&& parser)
+        : m_name{std::move(name)},
+          m_version{version},
+          m_parser{std::move(parser)}
+    {
+    }
+
+    [[nodiscard]] std::string_view name() const noexcept
+    {
+        return m_name;
+    }
+
+    // 1 for the first publish of a name, incremented by each hot-swap.
+    [[nodiscard]] std::uint64_t version() const noexcept
+    {
+        return m_version;
+    }
+
+    [[nodiscard]] const mcli::detail::command& schema() const noexcept
+    {
+        return m_parser.schema();
+    }
+
+    [[nodiscard]] parse::parse_result parse(
+            int argc,
+            char** argv,
+            parse::parse_options options = {}) const
+    {
+        std::lock_guard lock{m_parse_mutex};
+        return m_parser.parse(argc, argv, options);
+    }
+
+    /**
+     * @brief Parse and keep this schema locked until the returned
+     * lock is released. The caller keeps the schema alive meanwhile.
+     */
+    [[nodiscard]] locked_parse parse_locked(
+            int argc,
+            char** argv,
+            parse::parse_options options = {}) const
+    {
+        std::unique_lock lock{m_parse_mutex};
+        auto result = m_parser.parse(argc, argv, options);
+        return {nullptr, std::move(lock), std::move(result)};
+    }
+
+private:
+    std::string m_name;
+    std::uint64_t m_version;
+    mutable std::mutex m_parse_mutex;
+    mutable parse::command_parser m_parser;
+};
+
+/**
+ * @brief Shared reference to a published schema.
+ *
+ * Keeps that version alive, so a parse that started before a hot-swap
+ * or removal finishes against the schema it looked up.
+ */
+using schema_handle = std::shared_ptr<const registered_schema>;
+
+/**
+ * @brief Process-wide store of frozen command schemas, keyed by name.
+ *
+ * Names are spread over fixed shards. Each shard publishes an immutable
+ * table through an atomic pointer (read-copy-update): readers load it
+ * without waiting on any lock, writers copy the table, modify the copy and
+ * swap it in, serialized per shard only. Each table counts the readers
+ * pinning it, and a replaced table is freed once its own count drops to
+ * zero, by the next publish or by the last reader to let go of it;
+ * schemas live on while a handle to them exists.
+ */
+class schema_registry
+{
+public:
+    static constexpr std::size_t shard_count = 64;
+
+    schema_registry()
+    {
+        for (auto& s : m_shards)
+        {
+            s.owned = std::make_unique<const table>();
+            s.current.store(s.owned.get());
+        }
+    }
+
+    schema_registry(const schema_registry&) = delete;
+    schema_registry& operator=(const schema_registry&) = delete;
+
+    /**
+     * @brief Publish @p parser under @p name, replacing any earlier
+     * version. Returns the new version number.
+     */
+    std::uint64_t publish(std::string_view name, parse::command_parser&& parser)
+    {
+        utils::trace_scope trace{"mcli.registry.publish"};
+
+        auto& target = shard_for(name);
+        std::lock_guard lock{target.write_mutex};
+
+        const auto& current = *target.owned;
+        auto next = std::make_unique<table>();
+        next->entries.reserve(current.entries.size() + 1);
+
+        std::uint64_t version = 1;
+        for (const auto& entry : current.entries)
+        {
+            if (entry->name() == name)
+            {
+                version = entry->version() + 1;
+                continue;
+            }
+            next->entries.push_back(entry);
+        }
+        next->entries.push_back(std::make_shared<registered_schema>(
+                std::string{name}, version, std::move(parser)));
+        next->build_index();
+
+        replace(target, std::move(next));
+        return version;
+    }
+
+    /**
+     * @brief Unpublish @p name. In-flight parses keep their handle.
+     */
+    bool remove(std::string_view name)
+    {
+        auto& target = shard_for(name);
+        std::lock_guard lock{target.write_mutex};
+
+        const auto& current = *target.owned;
+        if (!current.index.find(name).has_value())
+        {
+            return false;
+        }
+
+        auto next = std::make_unique<table>();
+        next->entries.reserve(current.entries.size() - 1);
+        for (const auto& entry : current.entries)
+        {
+            if (entry->name() != name)
+            {
+                next->entries.push_back(entry);
+            }
+        }
+        next->build_index();
+
+        replace(target, std::move(next));
+        return true;
+    }
+
+    /**
+     * @brief Current version of @p name, or null if none is published.
+     */
+    [[nodiscard]] schema_handle find(std::string_view name) const
+    {
+        read_guard guard{shard_for(name)};
+        auto slot = guard.snapshot().index.find(name);
+        if (!slot.has_value())
+        {
+            return nullptr;
+        }
+        return guard.snapshot().entries[*slot];
+    }
+
+    /**
+     * @brief Look up @p name and parse against its current version.
+     *
+     * Reports unknown_command if nothing is published under @p name.
+     */
+    [[nodiscard]] parse::parse_result parse(
+            std::string_view name,
+            int argc,
+            char** argv,
+            parse::parse_options options = {}) const
+    {
+        auto handle = find(name);
+        if (handle == nullptr)
+        {
+            return unknown_command(name, options);
+        }
+        return handle->parse(argc, argv, options);
+    }
+
+    /**
+     * @brief Like parse(), but keeps the schema locked until the returned
+     * lock is released, so its bound variables can be read safely.
+     */
+    [[nodiscard]] locked_parse parse_locked(
+            std::string_view name,
+            int argc,
+            char** argv,
+            parse::parse_options options = {}) const
+    {
+        auto handle = find(name);
+        if (handle == nullptr)
+        {
+            return {nullptr, {}, unknown_command(name, options)};
+        }
+        auto locked = handle->parse_locked(argc, argv, options);
+        // A hot-swap must not free the mutex while it is held.
+        locked.schema = std::move(handle);
+        return locked;
+    }
+
+    // Number of published names. Not a snapshot across shards.
+    [[nodiscard]] std::size_t size() const
+    {
+        std::size_t count = 0;
+        for (const auto& s : m_shards)
+        {
+            read_guard guard{s};
+            count += guard.snapshot().entries.size();
+        }
+        return count;
+    }
+
+private:
+    // Immutable once published.
+    struct table
+    {
+        std::vector<schema_handle> entries;
+        utils::name_index index;  // name -> entries slot
+        mutable std::atomic<std::size_t> readers{0};
+
+        void build_index()
+        {
+            index.build(entries.size(),
+                        [this](std::size_t slot)
+                        { return entries[slot]->name(); });
+        }
+    };
+
+    // Own cache line each, so readers of different shards do not share
+    // the counters.
+    struct alignas(64) shard
+    {
+        std::atomic<const table*> current{nullptr};
+        // Readers between loading current and pinning that table.
+        mutable std::atomic<std::size_t> entering{0};
+        mutable std::atomic<std::size_t> retired_count{0};
+
+        mutable std::mutex write_mutex;  // guards the members below
+        std::unique_ptr<const table> owned;  // what current points to
+        mutable std::vector<std::unique_ptr<const table>> retired;
+    };
+
+    // Pins the shard's current table for the guard's lifetime.
+    class read_guard
+    {
+    public:
+        explicit read_guard(const shard& s) : m_shard{s}
+        {
+            // Pairs with the seq_cst store and load in replace() and
+            // reclaim(): either the writer sees this reader entering, or
+            // this reader sees the new table.
+            m_shard.entering.fetch_add(1);
+            m_table = m_shard.current.load();
+            m_table->readers.fetch_add(1);
+            m_shard.entering.fetch_sub(1);
+        }
+
+        read_guard(const read_guard&) = delete;
+        read_guard& operator=(const read_guard&) = delete;
+
+        ~read_guard()
+        {
+            m_table->readers.fetch_sub(1);
+
+            // Retry reclamation a publish had to defer. Never block a
+            // reader on a writer: if one holds the lock, it reclaims.
+            if (m_shard.retired_count.load() != 0)
+            {
+                std::unique_lock lock{m_shard.write_mutex, std::try_to_lock};
+                if (lock.owns_lock())
+                {
+                    reclaim(m_shard);
+                }
+            }
+        }
+
+        [[nodiscard]] const table& snapshot() const noexcept
+        {
+            return *m_table;
+        }
+
+    private:
+        const shard& m_shard;
+        const table* m_table{nullptr};
+    };
+
+    // Swap in @p next; called with the shard's write_mutex held.
+    static void replace(shard& target, std::unique_ptr<const table> next)
+    {
+        target.current.store(next.get());
+        target.retired.push_back(std::move(target.owned));
+        target.owned = std::move(next);
+        reclaim(target);
+    }
+
+    // Free the retired tables no reader pins; called with the shard's
+    // write_mutex held.
+    static void reclaim(const shard& target)
+    {
+        // A reader still entering may have loaded any retired table
+        // without having pinned it yet; try again later. Readers that
+        // enter after this check load a table that is not retired.
+        if (target.entering.load() == 0)
+        {
+            std::erase_if(target.retired,
+                          [](const std::unique_ptr<const table>& t)
+                          { return t->readers.load() == 0; });
+        }
+        target.retired_count.store(target.retired.size());
+    }
+
+    static parse::parse_result unknown_command(std::string_view name,
+                                               parse::parse_options options)
+    {
+        parse::diagnostic diag;
+        diag.code = parse::parse_error::unknown_command;
+        diag.token = name;
+
+        parse::parse_result result;
+        result.add_diagnostic(diag);
+        if (options.format_message)
+        {
+            result.set_message(std::string{"Unknown command: "}.append(name));
+        }
+        return result;
+    }
+
+    [[nodiscard]] shard& shard_for(std::string_view name)
+    {
+        return m_shards[utils::hash_name(name) % shard_count];
+    }
+
+    [[nodiscard]] const shard& shard_for(std::string_view name) const
+    {
+        return m_shards[utils::hash_name(name) % shard_count];
+    }
+
+    std::array<shard, shard_count> m_shards;
+};
+
+}  // namespace mcli::detail::registry
+
+#endif  // MCLI_DETAIL_REGISTRY_SCHEMA_REGISTRY_HPP_
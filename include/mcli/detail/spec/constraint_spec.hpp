@@ -0,0 +1,44 @@
+#ifndef MCLI_DETAIL_SPEC_CONSTRAINT_SPEC_HPP_
+#define MCLI_DETAIL_SPEC_CONSTRAINT_SPEC_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mcli::detail::spec
+{
+
+enum class constraint_kind
+{
+    requires_all,  // subject present -> all operands present
+    conflicts,     // at most one operand present
+    one_of,        // exactly one operand present
+};
+
+struct constraint_spec
+{
+    constraint_kind kind{constraint_kind::conflicts};
+    // Option names as given to the builder; resolved at build(), where
+    // "-k" names an alias and "--tls-key" or "tls-key" a long name.
+    std::string subject;                // "--tls-cert" (requires_all only)
+    std::vector<std::string> operands;  // {"--tls-key"}
+};
+
+// Constraint resolved against option slots at build().
+struct compiled_constraint
+{
+    static constexpr std::size_t no_subject = static_cast<std::size_t>(-1);
+
+    constraint_kind kind{constraint_kind::conflicts};
+    std::size_t subject{no_subject};
+
+    // Operand slots: chunks [mask_begin, mask_begin + mask_size) of
+    // command::constraint_chunks(), so all masks share one array.
+    std::uint32_t mask_begin{0};
+    std::uint32_t mask_size{0};
+};
+
+}  // namespace mcli::detail::spec
+
+#endif  // MCLI_DETAIL_SPEC_CONSTRAINT_SPEC_HPP_
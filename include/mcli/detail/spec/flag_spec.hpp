@@ -1,7 +1,9 @@
 #ifndef MCLI_DETAIL_SPEC_FLAG_SPEC_HPP_
 #define MCLI_DETAIL_SPEC_FLAG_SPEC_HPP_
 
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace mcli::detail::spec
 {
@@ -11,6 +13,19 @@ struct flag_spec
     std::string name;  // "--verbose"
     std::string abbr;  // "-v"
     std::string desc;  // help text
+    std::string env;   // environment variable, e.g. "APP_VERBOSE"
+    std::optional<bool> default_value;
+};
+
+// Non-owning flag definition for bulk registration, e.g. from generated
+// tables. Names are normalized like flag_builder's.
+struct flag_descriptor
+{
+    std::string_view name;  // "--verbose" or "verbose"
+    std::string_view abbr;  // "-v", "v" or empty
+    std::string_view desc;  // help text
+    bool* target{nullptr};
+    std::optional<bool> default_value{};
 };
 
 }  // namespace mcli::detail::spec
@@ -1,8 +1,12 @@
 #ifndef MCLI_DETAIL_SPEC_OPTION_HPP_
 #define MCLI_DETAIL_SPEC_OPTION_HPP_
 
+#include "mcli/detail/spec/option_target.hpp"
+#include "mcli/detail/utils/string_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <variant>
 
 namespace mcli::detail::spec
 {
@@ -19,17 +23,33 @@ enum class value_kind
 
 struct option_spec
 {
-    using Target = std::variant<std::monostate, bool*>;
-
-    std::string name;  // Full name, e.g. "verbose"
-    std::string abbr;  // Abbreviation, e.g. "v"
-    std::string desc;  // Help text
+    // Interned in the owning command's string pool.
+    utils::string_id name;  // Full name, e.g. "--verbose"
+    utils::string_id abbr;  // Abbreviation, e.g. "-v"
+    utils::string_id desc;  // Help text
     option_kind kind{option_kind::flag};
-    Target target{std::monostate{}};
+    option_target target;
     value_kind vkind{value_kind::boolean};
-    bool seen{false};
+};
+
+// Default value of one option: copy @p size bytes at @p offset of the
+// command's default blob into the bound object.
+struct default_initializer
+{
+    void* object{nullptr};
+    std::uint32_t offset{0};
+    std::uint32_t size{0};
+    std::size_t slot{0};
+};
+
+// Environment variable consulted when the option is not on the command
+// line.
+struct env_binding
+{
+    std::size_t slot{0};
+    std::string variable;  // e.g. "APP_VERBOSE"
 };
 
 }  // namespace mcli::detail::spec
 
-#endif  // MCLI_DETAIL_SPEC_OPTION_HPP_
\ No newline at end of file
+#endif  // MCLI_DETAIL_SPEC_OPTION_HPP_
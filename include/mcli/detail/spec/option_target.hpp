@@ -0,0 +1,114 @@
+#ifndef MCLI_DETAIL_SPEC_OPTION_TARGET_HPP_
+#define MCLI_DETAIL_SPEC_OPTION_TARGET_HPP_
+
+#include <cassert>
+#include <charconv>
+#include <concepts>
+#include <string>
+#include <string_view>
+
+namespace mcli::detail::spec
+{
+
+/**
+ * @brief Writes a matched value into a bound object.
+ *
+ * Returns false if @p value cannot be converted to the target type.
+ */
+using setter_fn = bool (*)(void* object, std::string_view value);
+
+/**
+ * @brief Type-erased binding of an option to its destination.
+ *
+ * The setter is chosen by the builder when the option is bound, so
+ * applying a matched option is a single indirect call with no dispatch
+ * on option or value kind.
+ */
+struct option_target
+{
+    void* object{nullptr};
+    setter_fn apply{nullptr};
+
+    bool operator()(std::string_view value) const
+    {
+        assert(object != nullptr && apply != nullptr);
+        return apply(object, value);
+    }
+};
+
+// Presence flag: seeing the option sets the target to true.
+inline bool set_flag(void* object, std::string_view /*value*/)
+{
+    *static_cast<bool*>(object) = true;
+    return true;
+}
+
+// Explicit boolean text, e.g. from the environment.
+inline bool set_boolean(void* object, std::string_view value)
+{
+    if (value == "1" || value == "true" || value == "yes" || value == "on")
+    {
+        *static_cast<bool*>(object) = true;
+        return true;
+    }
+    if (value == "0" || value == "false" || value == "no" || value == "off")
+    {
+        *static_cast<bool*>(object) = false;
+        return true;
+    }
+    return false;
+}
+
+inline option_target flag_target(bool& target)
+{
+    return option_target{&target, &set_flag};
+}
+
+// Values: convert the matched token into the target type.
+inline bool set_string(void* object, std::string_view value)
+{
+    static_cast<std::string*>(object)->assign(value);
+    return true;
+}
+
+inline bool set_string_view(void* object, std::string_view value)
+{
+    *static_cast<std::string_view*>(object) = value;
+    return true;
+}
+
+template <std::integral T>
+bool set_integer(void* object, std::string_view value)
+{
+    T parsed{};
+    const char* last = value.data() + value.size();
+    auto [ptr, ec] = std::from_chars(value.data(), last, parsed);
+    if (ec != std::errc{} || ptr != last)
+    {
+        return false;
+    }
+    *static_cast<T*>(object) = parsed;
+    return true;
+}
+
+inline option_target value_target(std::string& target)
+{
+    return option_target{&target, &set_string};
+}
+
+// The view refers into argv and is valid as long as argv is.
+inline option_target value_target(std::string_view& target)
+{
+    return option_target{&target, &set_string_view};
+}
+
+template <std::integral T>
+    requires(!std::same_as<T, bool>)
+option_target value_target(T& target)
+{
+    return option_target{&target, &set_integer<T>};
+}
+
+}  // namespace mcli::detail::spec
+
+#endif  // MCLI_DETAIL_SPEC_OPTION_TARGET_HPP_
@@ -0,0 +1,28 @@
+#ifndef MCLI_DETAIL_SPEC_POSITIONAL_SPEC_HPP_
+#define MCLI_DETAIL_SPEC_POSITIONAL_SPEC_HPP_
+
+#include "mcli/detail/spec/option_target.hpp"
+#include "mcli/detail/utils/string_pool.hpp"
+
+namespace mcli::detail::spec
+{
+
+enum class positional_kind
+{
+    required,  // exactly one argument
+    optional,  // zero or one argument
+    variadic,  // all remaining arguments, bound to an arg_range
+};
+
+struct positional_spec
+{
+    // Interned in the owning command's string pool.
+    utils::string_id name;  // Display name, e.g. "path"
+    utils::string_id desc;  // Help text
+    positional_kind kind{positional_kind::required};
+    option_target target;  // object is an arg_range* for variadic
+};
+
+}  // namespace mcli::detail::spec
+
+#endif  // MCLI_DETAIL_SPEC_POSITIONAL_SPEC_HPP_
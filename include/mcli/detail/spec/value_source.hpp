@@ -0,0 +1,42 @@
+#ifndef MCLI_DETAIL_SPEC_VALUE_SOURCE_HPP_
+#define MCLI_DETAIL_SPEC_VALUE_SOURCE_HPP_
+
+#include <cstdint>
+#include <string_view>
+
+namespace mcli::detail::spec
+{
+
+/**
+ * @brief Where an option's effective value came from in one parse.
+ */
+enum class value_source : std::uint8_t
+{
+    none,           // not set; the bound variable keeps its own value
+    default_value,  // declared default, applied by the parser
+    command_line,
+    environment,
+    config_file,    // reserved for configuration file loaders
+};
+
+constexpr std::string_view to_string(value_source source) noexcept
+{
+    switch (source)
+    {
+        case value_source::none:
+            return "none";
+        case value_source::default_value:
+            return "default";
+        case value_source::command_line:
+            return "command_line";
+        case value_source::environment:
+            return "environment";
+        case value_source::config_file:
+            return "config_file";
+    }
+    return "unknown";
+}
+
+}  // namespace mcli::detail::spec
+
+#endif  // MCLI_DETAIL_SPEC_VALUE_SOURCE_HPP_
@@ -0,0 +1,230 @@
+#ifndef MCLI_DETAIL_UTILS_BIT_SET_HPP_
+#define MCLI_DETAIL_UTILS_BIT_SET_HPP_
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace mcli::detail::utils
+{
+
+/**
+ * @brief One word of a sparse_mask: the bits set in word @c word.
+ */
+struct mask_chunk
+{
+    std::uint32_t word;
+    std::uint64_t bits;
+};
+
+/**
+ * @brief A few bits of a large slot space, as chunks ordered by word.
+ *
+ * A constraint names a handful of options, so its mask only touches the
+ * words those options fall into. Checking it against a bit_set costs one
+ * AND per touched word, however large the option table is.
+ */
+using sparse_mask = std::span<const mask_chunk>;
+
+/**
+ * @brief Append the chunks of the mask with bits @p slots set to @p out.
+ *
+ * @p slots must be sorted.
+ */
+inline void append_sparse_mask(std::span<const std::size_t> slots,
+                               std::vector<mask_chunk>& out)
+{
+    constexpr std::size_t word_bits = 64;
+
+    const std::size_t first = out.size();
+    for (auto slot : slots)
+    {
+        const auto word = static_cast<std::uint32_t>(slot / word_bits);
+        if (out.size() == first || out.back().word != word)
+        {
+            out.push_back(mask_chunk{word, 0});
+        }
+        out.back().bits |= std::uint64_t{1} << (slot % word_bits);
+    }
+}
+
+/**
+ * @brief Call @p fn with every position set in @p mask, in ascending
+ * order.
+ */
+template <typename Fn>
+void for_each_bit(sparse_mask mask, Fn&& fn)
+{
+    for (const auto& c : mask)
+    {
+        for (auto bits = c.bits; bits != 0; bits &= bits - 1)
+        {
+            fn(std::size_t{c.word} * 64 +
+               static_cast<std::size_t>(std::countr_zero(bits)));
+        }
+    }
+}
+
+/**
+ * @brief Runtime-sized bitset addressed by option slot.
+ *
+ * Tracks the options seen during a parse. Checking a sparse_mask against
+ * it costs one AND per word the mask touches.
+ */
+class bit_set
+{
+public:
+    using word_type = std::uint64_t;
+
+    static constexpr std::size_t word_bits = 64;
+
+    bit_set() = default;
+
+    explicit bit_set(std::size_t size)
+        : m_size{size}, m_words((size + word_bits - 1) / word_bits, 0)
+    {
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    void set(std::size_t pos) noexcept
+    {
+        assert(pos < m_size);
+        m_words[pos / word_bits] |= bit(pos);
+    }
+
+    [[nodiscard]] bool test(std::size_t pos) const noexcept
+    {
+        assert(pos < m_size);
+        return (m_words[pos / word_bits] & bit(pos)) != 0;
+    }
+
+    void clear() noexcept
+    {
+        for (auto& word : m_words)
+        {
+            word = 0;
+        }
+    }
+
+    [[nodiscard]] bool none() const noexcept
+    {
+        for (auto word : m_words)
+        {
+            if (word != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief True if every bit of @p mask is also set here.
+     */
+    [[nodiscard]] bool contains(sparse_mask mask) const noexcept
+    {
+        for (const auto& c : mask)
+        {
+            if ((m_words[c.word] & c.bits) != c.bits)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Number of bits set both here and in @p mask, saturated at 2.
+     *
+     * Constraints only tell none, one and several apart; this also keeps
+     * std::popcount, a library call on baseline x86-64, off the path.
+     */
+    [[nodiscard]] std::size_t count_common(sparse_mask mask) const noexcept
+    {
+        std::size_t count = 0;
+        for (const auto& c : mask)
+        {
+            const auto common = m_words[c.word] & c.bits;
+            if (common != 0)
+            {
+                count += (common & (common - 1)) != 0 ? 2 : 1;
+                if (count > 1)
+                {
+                    return 2;
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Position of the first bit set both here and in @p mask at or
+     * after @p from, or size() if there is none.
+     */
+    [[nodiscard]] std::size_t find_common(sparse_mask mask,
+                                          std::size_t from = 0) const noexcept
+    {
+        return find_first(mask, from, false);
+    }
+
+    /**
+     * @brief Position of the first bit set in @p mask but not here, or
+     * size() if there is none.
+     */
+    [[nodiscard]] std::size_t find_missing(
+            sparse_mask mask) const noexcept
+    {
+        return find_first(mask, 0, true);
+    }
+
+    [[nodiscard]] std::span<const word_type> words() const noexcept
+    {
+        return m_words;
+    }
+
+private:
+    static constexpr word_type bit(std::size_t pos) noexcept
+    {
+        return word_type{1} << (pos % word_bits);
+    }
+
+    [[nodiscard]] std::size_t find_first(sparse_mask mask,
+                                         std::size_t from,
+                                         bool invert) const noexcept
+    {
+        for (const auto& c : mask)
+        {
+            if (c.word < from / word_bits)
+            {
+                continue;
+            }
+            assert(c.word < m_words.size());
+            word_type word = invert ? (~m_words[c.word] & c.bits)
+                                    : (m_words[c.word] & c.bits);
+            if (c.word == from / word_bits)
+            {
+                word &= ~word_type{0} << (from % word_bits);
+            }
+            if (word != 0)
+            {
+                return std::size_t{c.word} * word_bits +
+                       static_cast<std::size_t>(std::countr_zero(word));
+            }
+        }
+        return m_size;
+    }
+
+    std::size_t m_size{0};
+    std::vector<word_type> m_words;
+};
+
+}  // namespace mcli::detail::utils
+
+#endif  // MCLI_DETAIL_UTILS_BIT_SET_HPP_
@@ -0,0 +1,68 @@
+#ifndef MCLI_DETAIL_UTILS_BUFFER_WRITER_HPP_
+#define MCLI_DETAIL_UTILS_BUFFER_WRITER_HPP_
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace mcli::detail::utils
+{
+
+/**
+ * @brief Appends text into a caller-provided buffer without allocating.
+ *
+ * Output past the end of the buffer is dropped but still counted, so
+ * size() reports the capacity needed for the complete text (like
+ * snprintf). No terminating NUL is written.
+ */
+class buffer_writer
+{
+public:
+    explicit buffer_writer(std::span<char> out) noexcept : m_out{out} {}
+
+    void append(std::string_view text) noexcept
+    {
+        for (char c : text)
+        {
+            append(c);
+        }
+    }
+
+    void append(char c) noexcept
+    {
+        if (m_size < m_out.size())
+        {
+            m_out[m_size] = c;
+        }
+        ++m_size;
+    }
+
+    void append_uint(std::uint64_t value) noexcept
+    {
+        char digits[20];
+        const char* end =
+                std::to_chars(std::begin(digits), std::end(digits), value).ptr;
+        append(std::string_view{digits,
+                                static_cast<std::size_t>(end - digits)});
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool truncated() const noexcept
+    {
+        return m_size > m_out.size();
+    }
+
+private:
+    std::span<char> m_out;
+    std::size_t m_size{0};
+};
+
+}  // namespace mcli::detail::utils
+
+#endif  // MCLI_DETAIL_UTILS_BUFFER_WRITER_HPP_
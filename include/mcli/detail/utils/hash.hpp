@@ -0,0 +1,29 @@
+#ifndef MCLI_DETAIL_UTILS_HASH_HPP_
+#define MCLI_DETAIL_UTILS_HASH_HPP_
+
+#include <cstdint>
+#include <string_view>
+
+namespace mcli::detail::utils
+{
+
+/**
+ * @brief 64-bit FNV-1a hash of a name.
+ *
+ * Stable across runs and platforms, so hashes can be precomputed once per
+ * schema and compared instead of strings.
+ */
+constexpr std::uint64_t hash_name(std::string_view name) noexcept
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (char c : name)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+}  // namespace mcli::detail::utils
+
+#endif  // MCLI_DETAIL_UTILS_HASH_HPP_
@@ -0,0 +1,241 @@
+#ifndef MCLI_DETAIL_UTILS_NAME_INDEX_HPP_
+#define MCLI_DETAIL_UTILS_NAME_INDEX_HPP_
+
+#include "mcli/detail/utils/hash.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mcli::detail::utils
+{
+
+/**
+ * @brief Runs fn(begin, end) over [0, count) on the calling thread.
+ *
+ * The default runner of name_index::build(). parallel_runner
+ * (parallel.hpp) has the same shape; only code that passes it
+ * instantiates threads.
+ */
+struct inline_runner
+{
+    [[nodiscard]] std::size_t workers() const noexcept
+    {
+        return 1;
+    }
+
+    template <typename Fn>
+    void operator()(std::size_t count, std::size_t /*grain*/, Fn&& fn) const
+    {
+        if (count > 0)
+        {
+            fn(std::size_t{0}, count);
+        }
+    }
+};
+
+/**
+ * @brief Frozen name -> slot lookup table.
+ *
+ * Open-addressing hash table split into independent shards. Given a
+ * parallel runner, building hashes the names and fills the shards on
+ * several threads for large schemas; every shard inserts its slots in
+ * ascending order, so the result (which slot wins, which duplicate is
+ * reported) is the same as a sequential build. Keys are views and must
+ * outlive the index.
+ */
+class name_index
+{
+public:
+    static constexpr std::uint32_t npos = UINT32_MAX;
+
+    // Below this many names the index is built on the calling thread.
+    static constexpr std::size_t parallel_threshold = 4096;
+
+    /**
+     * @brief (Re)build from @p count keys; empty keys are not indexed.
+     */
+    template <typename KeyFn>
+    void build(std::size_t count, KeyFn&& key_of)
+    {
+        build(count,
+              key_of,
+              [&](std::size_t slot) { return hash_name(key_of(slot)); });
+    }
+
+    /**
+     * @brief Same as above, reusing hashes the caller already has;
+     * hash_of(slot) must equal hash_name(key_of(slot)). Work is split
+     * by @p run, see inline_runner.
+     */
+    template <typename KeyFn, typename HashFn, typename Runner = inline_runner>
+    void build(std::size_t count,
+               KeyFn&& key_of,
+               HashFn&& hash_of,
+               const Runner& run = {})
+    {
+        m_shards.clear();
+        m_duplicate.reset();
+
+        std::vector<std::uint64_t> hashes(count);
+        run(count,
+            parallel_threshold,
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t slot = begin; slot < end; ++slot)
+                {
+                    hashes[slot] = hash_of(slot);
+                }
+            });
+
+        const std::size_t shard_count =
+                count < parallel_threshold
+                        ? 1
+                        : std::bit_ceil(std::max<std::size_t>(
+                                  1, run.workers()));
+        m_shard_mask = shard_count - 1;
+
+        // Bucket slots by shard, keeping ascending slot order.
+        std::vector<std::vector<std::uint32_t>> members(shard_count);
+        for (std::size_t slot = 0; slot < count; ++slot)
+        {
+            if (!key_of(slot).empty())
+            {
+                members[shard_of(hashes[slot])].push_back(
+                        static_cast<std::uint32_t>(slot));
+            }
+        }
+
+        m_shards.resize(shard_count);
+        std::vector<std::optional<std::pair<std::uint32_t, std::uint32_t>>>
+                duplicates(shard_count);
+
+        run(shard_count,
+            1,
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t s = begin; s < end; ++s)
+                {
+                    duplicates[s] =
+                            fill_shard(m_shards[s], members[s], hashes, key_of);
+                }
+            });
+
+        // Report the duplicate a sequential build would hit first.
+        for (const auto& dup : duplicates)
+        {
+            if (dup && (!m_duplicate || dup->second < m_duplicate->second))
+            {
+                m_duplicate = dup;
+            }
+        }
+    }
+
+    [[nodiscard]] std::optional<std::size_t> find(std::string_view key) const
+    {
+        if (m_shards.empty() || key.empty())
+        {
+            return std::nullopt;
+        }
+
+        const auto hash = hash_name(key);
+        const auto& shard = m_shards[shard_of(hash)];
+        if (shard.empty())
+        {
+            return std::nullopt;
+        }
+
+        const std::size_t mask = shard.size() - 1;
+        for (std::size_t pos = hash & mask;; pos = (pos + 1) & mask)
+        {
+            const auto& entry = shard[pos];
+            if (entry.slot == npos)
+            {
+                return std::nullopt;
+            }
+            if (entry.hash == hash && entry.key == key)
+            {
+                return entry.slot;
+            }
+        }
+    }
+
+    /**
+     * @brief First (earlier slot, later slot) pair sharing a key, if any.
+     */
+    [[nodiscard]] std::optional<std::pair<std::uint32_t, std::uint32_t>>
+    duplicate() const noexcept
+    {
+        return m_duplicate;
+    }
+
+private:
+    struct entry
+    {
+        std::string_view key;
+        std::uint64_t hash{0};
+        std::uint32_t slot{npos};
+    };
+
+    using shard = std::vector<entry>;
+
+    [[nodiscard]] std::size_t shard_of(std::uint64_t hash) const noexcept
+    {
+        return static_cast<std::size_t>(hash >> 48U) & m_shard_mask;
+    }
+
+    template <typename KeyFn>
+    static std::optional<std::pair<std::uint32_t, std::uint32_t>> fill_shard(
+            shard& table,
+            const std::vector<std::uint32_t>& slots,
+            const std::vector<std::uint64_t>& hashes,
+            KeyFn& key_of)
+    {
+        std::optional<std::pair<std::uint32_t, std::uint32_t>> duplicate;
+        if (slots.empty())
+        {
+            return duplicate;
+        }
+
+        // Keep the load factor at or below 1/2.
+        table.assign(std::bit_ceil(slots.size() * 2), entry{});
+        const std::size_t mask = table.size() - 1;
+
+        for (auto slot : slots)
+        {
+            const auto hash = hashes[slot];
+            const std::string_view key = key_of(slot);
+            for (std::size_t pos = hash & mask;; pos = (pos + 1) & mask)
+            {
+                auto& e = table[pos];
+                if (e.slot == npos)
+                {
+                    e = entry{key, hash, slot};
+                    break;
+                }
+                if (e.hash == hash && e.key == key)
+                {
+                    if (!duplicate)
+                    {
+                        duplicate.emplace(e.slot, slot);
+                    }
+                    break;
+                }
+            }
+        }
+        return duplicate;
+    }
+
+    std::vector<shard> m_shards;
+    std::size_t m_shard_mask{0};
+    std::optional<std::pair<std::uint32_t, std::uint32_t>> m_duplicate;
+};
+
+}  // namespace mcli::detail::utils
+
+#endif  // MCLI_DETAIL_UTILS_NAME_INDEX_HPP_
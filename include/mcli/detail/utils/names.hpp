@@ -0,0 +1,134 @@
+#ifndef MCLI_DETAIL_UTILS_NAMES_HPP_
+#define MCLI_DETAIL_UTILS_NAMES_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace mcli::detail::utils
+{
+
+inline std::string normalize_long_name(std::string_view name)
+{
+    if (name.empty())
+    {
+        return {};
+    }
+
+    if (name.rfind("--", 0) == 0)  // already starts with "--"
+    {
+        return std::string{name};
+    }
+
+    // optional: allow a single '-' and upgrade to '--'?
+    // if (name.front() == '-' && name.size() > 1 && name[1] != '-')
+    //     return std::string{"--"} + std::string{name.substr(1)};
+
+    std::string normalized;
+    normalized.reserve(name.size() + 2);
+    normalized.append("--").append(name);
+    return normalized;
+}
+
+inline std::string normalize_short_name(std::string_view abbr)
+{
+    if (abbr.empty())
+    {
+        return {};
+    }
+
+    if (abbr.rfind('-', 0) == 0)  // already starts with '-'
+    {
+        // optional: reject "--" here since that's a long option shape
+        return std::string{abbr};
+    }
+
+    std::string normalized;
+    normalized.reserve(abbr.size() + 1);
+    normalized.append("-").append(abbr);
+    return normalized;
+}
+
+/**
+ * @brief True if a token is a negative number such as "-5" or "-2.5".
+ */
+inline bool looks_like_negative_number(std::string_view tok)
+{
+    if (tok.size() < 2 || tok.front() != '-')
+    {
+        return false;
+    }
+
+    bool digit = false;
+    bool point = false;
+    for (char c : tok.substr(1))
+    {
+        if (c >= '0' && c <= '9')
+        {
+            digit = true;
+        }
+        else if (c == '.' && !point)
+        {
+            point = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return digit;
+}
+
+/**
+ * @brief True if a command-line token has the shape of an option.
+ *
+ * A lone "-" is a positional (conventionally stdin), as is anything
+ * after the "--" terminator; callers handle the terminator themselves.
+ * Negative numbers are positionals too, so aliases never look like one.
+ */
+inline bool looks_like_option(std::string_view tok)
+{
+    return tok.size() > 1 && tok.front() == '-' &&
+           !looks_like_negative_number(tok);
+}
+
+/**
+ * @brief Levenshtein distance between two option names.
+ *
+ * Used to suggest candidates for unknown options. Names longer than the
+ * internal row buffer are never considered similar.
+ */
+inline std::size_t edit_distance(std::string_view lhs, std::string_view rhs)
+{
+    constexpr std::size_t max_length = 63;
+    if (lhs.size() > max_length || rhs.size() > max_length)
+    {
+        return std::max(lhs.size(), rhs.size());
+    }
+
+    std::array<std::size_t, max_length + 1> row{};
+    for (std::size_t j = 0; j <= rhs.size(); ++j)
+    {
+        row[j] = j;
+    }
+
+    for (std::size_t i = 1; i <= lhs.size(); ++i)
+    {
+        std::size_t diagonal = row[0];
+        row[0] = i;
+        for (std::size_t j = 1; j <= rhs.size(); ++j)
+        {
+            std::size_t above = row[j];
+            std::size_t cost = lhs[i - 1] == rhs[j - 1] ? 0 : 1;
+            row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + cost});
+            diagonal = above;
+        }
+    }
+    return row[rhs.size()];
+}
+
+}  // namespace mcli::detail::utils
+
+#endif  // MCLI_DETAIL_UTILS_NAMES_HPP_
@@ -0,0 +1,78 @@
+#ifndef MCLI_DETAIL_UTILS_PARALLEL_HPP_
+#define MCLI_DETAIL_UTILS_PARALLEL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace mcli::detail::utils
+{
+
+/**
+ * @brief Run @p fn(begin, end) over [0, count) in chunks of @p grain.
+ *
+ * Chunks are handed out to up to hardware_concurrency() threads from a
+ * shared counter. Small inputs run inline on the calling thread, so the
+ * cost for ordinary CLIs is a single comparison. @p fn must only write
+ * state owned by its chunk.
+ */
+template <typename Fn>
+void parallel_for(std::size_t count, std::size_t grain, Fn&& fn)
+{
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    const std::size_t workers = std::min<std::size_t>(
+            chunks, std::max(1U, std::thread::hardware_concurrency()));
+
+    if (workers <= 1)
+    {
+        if (count > 0)
+        {
+            fn(std::size_t{0}, count);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto work = [&]
+    {
+        for (std::size_t chunk = next.fetch_add(1); chunk < chunks;
+             chunk = next.fetch_add(1))
+        {
+            const std::size_t begin = chunk * grain;
+            fn(begin, std::min(begin + grain, count));
+        }
+    };
+
+    std::vector<std::jthread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t i = 1; i < workers; ++i)
+    {
+        threads.emplace_back(work);
+    }
+    work();
+}
+
+/**
+ * @brief Runner for name_index::build() and command::add_flags() that
+ * spreads work with parallel_for().
+ */
+struct parallel_runner
+{
+    [[nodiscard]] std::size_t workers() const noexcept
+    {
+        return std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    template <typename Fn>
+    void operator()(std::size_t count, std::size_t grain, Fn&& fn) const
+    {
+        parallel_for(count, grain, fn);
+    }
+};
+
+}  // namespace mcli::detail::utils
+
+#endif  // MCLI_DETAIL_UTILS_PARALLEL_HPP_
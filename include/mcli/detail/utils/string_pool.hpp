@@ -0,0 +1,221 @@
+#ifndef MCLI_DETAIL_UTILS_STRING_POOL_HPP_
+#define MCLI_DETAIL_UTILS_STRING_POOL_HPP_
+
+#include "mcli/detail/utils/hash.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcli::detail::utils
+{
+
+/**
+ * @brief Handle to a string interned in a string_pool.
+ *
+ * Equal strings in one pool always get the same id, so ids can be
+ * compared instead of text. The default id is the empty string.
+ */
+struct string_id
+{
+    std::uint32_t value{0};
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return value == 0;
+    }
+
+    friend bool operator==(string_id, string_id) = default;
+};
+
+/**
+ * @brief Deduplicated, contiguous storage for schema strings.
+ *
+ * Every distinct string is stored once in a single character buffer and
+ * addressed by 32-bit offset, together with its precomputed hash. Each
+ * command owns its own pool, so strings repeated within a command (help
+ * text shared by several options, generated descriptions) cost one
+ * 16-byte entry instead of a std::string each; separate commands do not
+ * share storage.
+ *
+ * Views returned by view() are invalidated when new strings are interned;
+ * a frozen schema stops interning before handing out views.
+ */
+class string_pool
+{
+public:
+    string_pool()
+    {
+        m_entries.push_back(entry{0, 0, hash_name({})});
+    }
+
+    string_id intern(std::string_view text)
+    {
+        return intern(text, hash_name(text));
+    }
+
+    /**
+     * @brief Intern @p text whose hash_name() is already known.
+     */
+    string_id intern(std::string_view text, std::uint64_t hash)
+    {
+        assert(hash == hash_name(text));
+        if (text.empty())
+        {
+            return string_id{};
+        }
+        if (auto found = find(text, hash))
+        {
+            return *found;
+        }
+
+        // Appending may reallocate the buffer @p text points into.
+        if (overlaps(text))
+        {
+            std::string copy{text};
+            return append(copy, hash);
+        }
+        return append(text, hash);
+    }
+
+    [[nodiscard]] std::optional<string_id> find(std::string_view text) const
+    {
+        return find(text, hash_name(text));
+    }
+
+    [[nodiscard]] std::optional<string_id> find(std::string_view text,
+                                                std::uint64_t hash) const
+    {
+        if (text.empty())
+        {
+            return string_id{};
+        }
+        if (m_buckets.empty())
+        {
+            return std::nullopt;
+        }
+
+        const std::size_t mask = m_buckets.size() - 1;
+        for (std::size_t pos = hash & mask;; pos = (pos + 1) & mask)
+        {
+            const auto index = m_buckets[pos];
+            if (index == empty_bucket)
+            {
+                return std::nullopt;
+            }
+            const auto& e = m_entries[index];
+            if (e.hash == hash && view(e) == text)
+            {
+                return string_id{index};
+            }
+        }
+    }
+
+    [[nodiscard]] std::string_view view(string_id id) const
+    {
+        return view(m_entries[id.value]);
+    }
+
+    [[nodiscard]] std::uint64_t hash(string_id id) const
+    {
+        return m_entries[id.value].hash;
+    }
+
+    // Number of distinct strings, including the empty string.
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_entries.size();
+    }
+
+    // Heap bytes held by the pool.
+    [[nodiscard]] std::size_t memory_bytes() const noexcept
+    {
+        return m_chars.capacity() + m_entries.capacity() * sizeof(entry) +
+               m_buckets.capacity() * sizeof(std::uint32_t);
+    }
+
+private:
+    static constexpr std::uint32_t empty_bucket = UINT32_MAX;
+
+    struct entry
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+        std::uint64_t hash;
+    };
+
+    [[nodiscard]] std::string_view view(const entry& e) const
+    {
+        return std::string_view{m_chars.data() + e.offset, e.length};
+    }
+
+    [[nodiscard]] bool overlaps(std::string_view text) const noexcept
+    {
+        const std::less<const char*> before;
+        const char* begin = m_chars.data();
+        const char* end = begin + m_chars.size();
+        return begin != nullptr && !before(text.data(), begin) &&
+               before(text.data(), end);
+    }
+
+    string_id append(std::string_view text, std::uint64_t hash)
+    {
+        assert(m_chars.size() + text.size() <= UINT32_MAX &&
+               "string pool exceeds 32-bit offsets");
+
+        const auto index = static_cast<std::uint32_t>(m_entries.size());
+        m_entries.push_back(entry{static_cast<std::uint32_t>(m_chars.size()),
+                                  static_cast<std::uint32_t>(text.size()),
+                                  hash});
+        m_chars.insert(m_chars.end(), text.begin(), text.end());
+
+        // Keep the load factor at or below 1/2.
+        if (m_entries.size() * 2 > m_buckets.size())
+        {
+            rehash(std::max<std::size_t>(16, m_buckets.size() * 2));
+        }
+        else
+        {
+            insert_bucket(index);
+        }
+        return string_id{index};
+    }
+
+    void rehash(std::size_t bucket_count)
+    {
+        m_buckets.assign(std::bit_ceil(bucket_count), empty_bucket);
+        for (std::uint32_t index = 1; index < m_entries.size(); ++index)
+        {
+            insert_bucket(index);
+        }
+    }
+
+    void insert_bucket(std::uint32_t index)
+    {
+        const std::size_t mask = m_buckets.size() - 1;
+        for (std::size_t pos = m_entries[index].hash & mask;;
+             pos = (pos + 1) & mask)
+        {
+            if (m_buckets[pos] == empty_bucket)
+            {
+                m_buckets[pos] = index;
+                return;
+            }
+        }
+    }
+
+    std::vector<char> m_chars;
+    std::vector<entry> m_entries;
+    std::vector<std::uint32_t> m_buckets;
+};
+
+}  // namespace mcli::detail::utils
+
+#endif  // MCLI_DETAIL_UTILS_STRING_POOL_HPP_
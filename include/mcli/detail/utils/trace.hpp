@@ -0,0 +1,352 @@
+#ifndef MCLI_DETAIL_UTILS_TRACE_HPP_
+#define MCLI_DETAIL_UTILS_TRACE_HPP_
+
+// Startup-cost tracing of CLI definition and parsing.
+//
+// Enabled at run time by setting MCLI_TRACE to an output path (or "1" for
+// mcli-trace.json) before the first mcli::define(), or by the hidden
+// --mcli-trace[=path] flag. To trace CLI setup the flag must be seen before
+// setup starts: call mcli::trace_from_args(argc, argv) before define(). A
+// parser that meets the flag without that call only enables tracing from
+// that point on, so setup and the running parse are not recorded. Events
+// are recorded into a fixed lock-free ring buffer without allocating and
+// written as Chrome trace-event JSON at exit (load it in chrome://tracing
+// or Perfetto).
+//
+// When tracing is off a scope costs one relaxed atomic load. Define
+// MCLI_DISABLE_TRACE to compile it out entirely.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+namespace mcli::detail::utils
+{
+
+class tracer
+{
+public:
+    static constexpr std::size_t capacity = 4096;
+    static constexpr std::string_view default_path = "mcli-trace.json";
+    static constexpr std::string_view reserved_flag = "--mcli-trace";
+
+    constexpr tracer() = default;
+
+    [[nodiscard]] bool enabled() const noexcept
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Start recording. If @p path is non-empty the trace is written
+     * there at exit.
+     */
+    void enable(std::string_view path = {})
+    {
+        if (!path.empty())
+        {
+            auto size = std::min(path.size(), m_path.size() - 1);
+            path.copy(m_path.data(), size);
+            m_path[size] = '\0';
+            if (!m_exit_hook.exchange(true))
+            {
+                std::atexit([] { instance().write_to_path(); });
+            }
+        }
+        // Keep the origin of a trace that is already running.
+        if (!enabled())
+        {
+            m_origin.store(now(), std::memory_order_relaxed);
+        }
+        m_enabled.store(true, std::memory_order_release);
+    }
+
+    void disable() noexcept
+    {
+        m_enabled.store(false, std::memory_order_release);
+    }
+
+    // Drop recorded events and stop writing at exit.
+    void reset() noexcept
+    {
+        disable();
+        m_path[0] = '\0';
+        m_next.store(0, std::memory_order_relaxed);
+        for (auto& event : m_events)
+        {
+            event.sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Enable from the MCLI_TRACE environment variable, once.
+     */
+    void enable_from_env()
+    {
+        if (m_env_checked.exchange(true, std::memory_order_relaxed))
+        {
+            return;
+        }
+        const char* env = std::getenv("MCLI_TRACE");
+        const std::string_view value = env != nullptr ? env : "";
+        if (value.empty() || value == "0")
+        {
+            return;
+        }
+        enable(value == "1" ? default_path : value);
+    }
+
+    /**
+     * @brief Handle the hidden --mcli-trace[=path] flag.
+     *
+     * Returns true if @p tok is the reserved flag.
+     */
+    bool enable_from_flag(std::string_view tok)
+    {
+        if (tok.rfind(reserved_flag, 0) != 0)
+        {
+            return false;
+        }
+        auto rest = tok.substr(reserved_flag.size());
+        if (rest.empty())
+        {
+            enable(default_path);
+            return true;
+        }
+        if (rest.front() != '=' || rest.size() == 1)
+        {
+            return false;
+        }
+        enable(rest.substr(1));
+        return true;
+    }
+
+    /**
+     * @brief Scan argv (before the first "--") for the hidden flag.
+     */
+    void enable_from_args(int argc, char** argv)
+    {
+        for (int index = 1; index < argc; ++index)
+        {
+            const std::string_view tok{argv[index]};
+            if (tok == "--")
+            {
+                return;
+            }
+            if (enable_from_flag(tok))
+            {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Record a completed span. Lock-free and allocation-free; when
+     * the buffer is full the oldest events are overwritten.
+     */
+    void record(const char* name,
+                std::uint64_t start_ns,
+                std::uint64_t end_ns) noexcept
+    {
+        const auto index = m_next.fetch_add(1, std::memory_order_relaxed);
+        auto& event = m_events[index % capacity];
+
+        // Invalidate the slot while writing so a concurrent dump skips it.
+        event.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        event.name.store(name, std::memory_order_relaxed);
+        event.start_ns.store(start_ns, std::memory_order_relaxed);
+        event.duration_ns.store(end_ns - start_ns, std::memory_order_relaxed);
+        event.thread.store(thread_tag(), std::memory_order_relaxed);
+        event.sequence.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Write recorded events as Chrome trace-event JSON.
+     *
+     * Safe to call while other threads record: an event is copied and
+     * then its sequence is checked again, so one overwritten meanwhile is
+     * skipped rather than written torn.
+     */
+    void dump(std::FILE* out) const
+    {
+        const auto origin = m_origin.load(std::memory_order_relaxed);
+        const auto next = m_next.load(std::memory_order_acquire);
+        const auto first = next > capacity ? next - capacity : 0;
+
+        std::fputs("{\"traceEvents\":[", out);
+        bool comma = false;
+        for (auto index = first; index < next; ++index)
+        {
+            const auto& event = m_events[index % capacity];
+            if (event.sequence.load(std::memory_order_acquire) != index + 1)
+            {
+                continue;
+            }
+            const char* name = event.name.load(std::memory_order_relaxed);
+            const auto start_ns =
+                    event.start_ns.load(std::memory_order_relaxed);
+            const auto duration_ns =
+                    event.duration_ns.load(std::memory_order_relaxed);
+            const auto thread = event.thread.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (event.sequence.load(std::memory_order_relaxed) != index + 1)
+            {
+                continue;
+            }
+            std::fprintf(out,
+                         "%s\n{\"name\":\"%s\",\"cat\":\"mcli\",\"ph\":\"X\","
+                         "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                         comma ? "," : "",
+                         name,
+                         static_cast<double>(start_ns - origin) / 1e3,
+                         static_cast<double>(duration_ns) / 1e3,
+                         thread);
+            comma = true;
+        }
+        std::fputs("\n],\"displayTimeUnit\":\"ns\"}\n", out);
+    }
+
+    static std::uint64_t now() noexcept
+    {
+        return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count());
+    }
+
+    static tracer& instance() noexcept;
+
+private:
+    // Fields are atomics so a dump racing record() is well defined; the
+    // sequence check tells whether the copy is consistent.
+    struct event
+    {
+        std::atomic<std::uint64_t> sequence{0};  // index + 1 once written
+        std::atomic<const char*> name{nullptr};
+        std::atomic<std::uint64_t> start_ns{0};
+        std::atomic<std::uint64_t> duration_ns{0};
+        std::atomic<std::uint32_t> thread{0};
+    };
+
+    // Small per-thread number, assigned on a thread's first event.
+    std::uint32_t thread_tag() noexcept
+    {
+        thread_local const std::uint32_t tag =
+                m_threads.fetch_add(1, std::memory_order_relaxed) + 1;
+        return tag;
+    }
+
+    void write_to_path() const
+    {
+        if (m_path[0] == '\0')
+        {
+            return;
+        }
+        if (std::FILE* out = std::fopen(m_path.data(), "w"))
+        {
+            dump(out);
+            std::fclose(out);
+        }
+    }
+
+    std::atomic<bool> m_enabled{false};
+    std::atomic<bool> m_env_checked{false};
+    std::atomic<bool> m_exit_hook{false};
+    std::atomic<std::uint64_t> m_origin{0};
+    std::atomic<std::uint64_t> m_next{0};
+    std::atomic<std::uint32_t> m_threads{0};
+    std::array<char, 512> m_path{};
+    std::array<event, capacity> m_events{};
+};
+
+// Constant-initialized, so the off state needs no startup work.
+inline constinit tracer g_tracer{};
+
+inline tracer& tracer::instance() noexcept
+{
+    return g_tracer;
+}
+
+/**
+ * @brief Timestamp for a span that will be closed by trace_end(), or 0
+ * when tracing is off.
+ */
+inline std::uint64_t trace_begin() noexcept
+{
+#ifdef MCLI_DISABLE_TRACE
+    return 0;
+#else
+    return g_tracer.enabled() ? tracer::now() : 0;
+#endif
+}
+
+/**
+ * @brief Record the span opened by trace_begin() under @p name, which must
+ * be a string literal or otherwise outlive the process.
+ */
+inline void trace_end(const char* name, std::uint64_t start) noexcept
+{
+    if (start != 0)
+    {
+        g_tracer.record(name, start, tracer::now());
+    }
+}
+
+/**
+ * @brief Honor MCLI_TRACE; called from mcli::define().
+ */
+inline void trace_init()
+{
+#ifndef MCLI_DISABLE_TRACE
+    g_tracer.enable_from_env();
+#endif
+}
+
+/**
+ * @brief Honor MCLI_TRACE and a --mcli-trace[=path] argument before any
+ * CLI setup runs.
+ */
+inline void trace_init(int argc, char** argv)
+{
+#ifndef MCLI_DISABLE_TRACE
+    g_tracer.enable_from_env();
+    g_tracer.enable_from_args(argc, argv);
+#else
+    static_cast<void>(argc);
+    static_cast<void>(argv);
+#endif
+}
+
+/**
+ * @brief Records the lifetime of a scope as one trace event.
+ */
+class trace_scope
+{
+public:
+    explicit trace_scope(const char* name) noexcept
+        : m_name{name}, m_start{trace_begin()}
+    {
+    }
+
+    ~trace_scope()
+    {
+        trace_end(m_name, m_start);
+    }
+
+    trace_scope(const trace_scope&) = delete;
+    trace_scope& operator=(const trace_scope&) = delete;
+
+private:
+    const char* m_name;
+    std::uint64_t m_start;
+};
+
+}  // namespace mcli::detail::utils
+
+#endif  // MCLI_DETAIL_UTILS_TRACE_HPP_
@@ -2,16 +2,42 @@
 #define MCLI_MCLI_HPP
 
 #include "mcli/detail/builder/command_builder.hpp"
+#include "mcli/detail/parse/arg_range.hpp"
+#include "mcli/detail/spec/value_source.hpp"
+#include "mcli/detail/utils/trace.hpp"
 #include "mcli/version.hpp"
 
 namespace mcli
 {
 
+/**
+ * @brief Lazy view over the arguments taken by a variadic positional.
+ */
+using arg_range = detail::parse::arg_range;
+
+/**
+ * @brief Origin of an option's value, see parse_result::sources().
+ */
+using value_source = detail::spec::value_source;
+
+/**
+ * @brief Enable tracing from MCLI_TRACE or a --mcli-trace[=file] argument.
+ *
+ * Call before define() so CLI setup is traced too; the parser still
+ * accepts and skips the flag.
+ */
+inline void trace_from_args(int argc, char** argv)
+{
+    detail::utils::trace_init(argc, argv);
+}
+
 /**
  * @brief Define a command-line interface.
  */
-[[nodiscard]] detail::builder::command_builder define()
+[[nodiscard]] inline detail::builder::command_builder define()
 {
+    detail::utils::trace_init();
+    detail::utils::trace_scope trace{"mcli.define"};
     return detail::builder::command_builder{};
 }
 
@@ -0,0 +1,30 @@
+#ifndef MCLI_REGISTRY_HPP
+#define MCLI_REGISTRY_HPP
+
+#include "mcli/detail/registry/schema_registry.hpp"
+#include "mcli/mcli.hpp"
+
+namespace mcli
+{
+
+/**
+ * @brief Thread-safe store of many CLIs by name, e.g. in a plugin host.
+ *
+ * Separate from mcli.hpp so single-CLI programs do not pay for
+ * <atomic>/<mutex>.
+ */
+using schema_registry = detail::registry::schema_registry;
+
+/**
+ * @brief A published schema version, kept alive while held.
+ */
+using schema_handle = detail::registry::schema_handle;
+
+/**
+ * @brief A parse result that keeps its schema locked while held.
+ */
+using locked_parse = detail::registry::locked_parse;
+
+}  // namespace mcli
+
+#endif  // MCLI_REGISTRY_HPP
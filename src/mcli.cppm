@@ -0,0 +1,72 @@
+// Primary module interface for `import mcli;`.
+//
+// The headers are included in the global module fragment and the public
+// names are re-exported, so the module and the header-only library always
+// describe the same entities.
+module;
+
+#include "mcli/mcli.hpp"
+#include "mcli/registry.hpp"
+#include "mcli/version.hpp"
+
+export module mcli;
+
+export namespace mcli
+{
+
+using mcli::arg_range;
+using mcli::define;
+using mcli::locked_parse;
+using mcli::schema_handle;
+using mcli::schema_registry;
+using mcli::trace_from_args;
+using mcli::value_source;
+using mcli::Version;
+using mcli::version;
+
+}  // namespace mcli
+
+export namespace mcli::detail::builder
+{
+
+using mcli::detail::builder::command_builder;
+using mcli::detail::builder::flag_builder;
+using mcli::detail::builder::positional_builder;
+
+}  // namespace mcli::detail::builder
+
+export namespace mcli::detail::parse
+{
+
+using mcli::detail::parse::arg_range;
+using mcli::detail::parse::command_parser;
+using mcli::detail::parse::diagnostic;
+using mcli::detail::parse::parse_error;
+using mcli::detail::parse::parse_options;
+using mcli::detail::parse::parse_result;
+using mcli::detail::parse::render_ansi;
+using mcli::detail::parse::render_json;
+using mcli::detail::parse::render_text;
+using mcli::detail::parse::text_style;
+using mcli::detail::parse::to_string;
+
+}  // namespace mcli::detail::parse
+
+export namespace mcli::detail::registry
+{
+
+using mcli::detail::registry::locked_parse;
+using mcli::detail::registry::registered_schema;
+using mcli::detail::registry::schema_handle;
+using mcli::detail::registry::schema_registry;
+
+}  // namespace mcli::detail::registry
+
+export namespace mcli::detail::spec
+{
+
+using mcli::detail::spec::flag_descriptor;
+using mcli::detail::spec::to_string;
+using mcli::detail::spec::value_source;
+
+}  // namespace mcli::detail::spec
@@ -0,0 +1,2 @@
+// Anchor translation unit for the shared mcli precompiled header; the
+// header itself is injected by target_precompile_headers().
@@ -0,0 +1,136 @@
+#include "mcli/mcli.hpp"
+#include "utils/args_builder.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using mcli::define;
+using mcli::detail::spec::flag_descriptor;
+using test::utils::make_argv;
+
+namespace
+{
+
+// Generated-looking table: "--flag-N" / "-fN" / help text.
+struct table
+{
+    explicit table(std::size_t count) : values(new bool[count]{})
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            names.push_back("flag-" + std::to_string(i));
+            abbrs.push_back("f" + std::to_string(i));
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            descriptors.push_back(
+                    {names[i], abbrs[i], "Generated flag", &values[i]});
+        }
+    }
+
+    std::vector<std::string> names;
+    std::vector<std::string> abbrs;
+    std::unique_ptr<bool[]> values;
+    std::vector<flag_descriptor> descriptors;
+};
+
+}  // namespace
+
+TEST(BulkFlags, MixesWithBuilderFlags)
+{
+    bool verbose = false;
+    table generated{3};
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--verbose")
+            .help("Enable verbose logging")
+            .bind(verbose)
+        .flags(generated.descriptors)
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] =
+            make_argv({"app", "--flag-2", "-f0", "--verbose"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_TRUE(result);
+    EXPECT_TRUE(verbose);
+    EXPECT_TRUE(generated.values[0]);
+    EXPECT_FALSE(generated.values[1]);
+    EXPECT_TRUE(generated.values[2]);
+    EXPECT_EQ(cli.schema().option_name(1), "--flag-0");
+}
+
+TEST(BulkFlags, LargeBatchMatchesSequentialBuild)
+{
+    // Above the parallel threshold, so indexing runs on several threads.
+    constexpr std::size_t count = 20'000;
+    table bulk{count};
+    table sequential{count};
+
+    auto bulk_cli = define().flags(bulk.descriptors).build();
+
+    auto builder = define();
+    for (const auto& desc : sequential.descriptors)
+    {
+        builder.flag()
+                .name(desc.name)
+                .abbr(desc.abbr)
+                .help(desc.desc)
+                .bind(*desc.target);
+    }
+    auto sequential_cli = builder.build();
+
+    const auto& lhs = bulk_cli.schema();
+    const auto& rhs = sequential_cli.schema();
+    ASSERT_EQ(lhs.option_count(), rhs.option_count());
+    for (std::size_t slot = 0; slot < count; ++slot)
+    {
+        const auto name = lhs.option_name(slot);
+        const auto abbr = lhs.option_abbr(slot);
+        ASSERT_EQ(name, rhs.option_name(slot));
+        ASSERT_EQ(lhs.find_option_by_name(name), slot);
+        ASSERT_EQ(rhs.find_option_by_name(name), slot);
+        ASSERT_EQ(lhs.find_option_by_abbr(abbr), slot);
+    }
+    EXPECT_FALSE(lhs.find_option_by_name("--flag-20000").has_value());
+
+    const auto [argc, argv] = make_argv({"app", "--flag-19999", "-f12345"});
+    ASSERT_TRUE(bulk_cli.parse(argc, argv));
+    EXPECT_TRUE(bulk.values[19'999]);
+    EXPECT_TRUE(bulk.values[12'345]);
+}
+
+#ifndef NDEBUG
+TEST(BulkFlagsDeathTest, DuplicateNameIsRejectedAtBuild)
+{
+    table generated{5000};
+    generated.descriptors[4321].name = "flag-17";
+
+    EXPECT_DEATH(
+            {
+                auto cli = define().flags(generated.descriptors).build();
+                static_cast<void>(cli);
+            },
+            "option name must be unique");
+}
+
+TEST(BulkFlagsDeathTest, DescriptorNeedsNameAndHelp)
+{
+    table unnamed{3};
+    unnamed.descriptors[1].name = "";
+    EXPECT_DEATH(
+            { define().flags(unnamed.descriptors); }, "flag must have a name");
+
+    table undocumented{3};
+    undocumented.descriptors[2].desc = "";
+    EXPECT_DEATH(
+            { define().flags(undocumented.descriptors); },
+            "flag should have help text");
+}
+#endif
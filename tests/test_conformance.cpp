@@ -0,0 +1,449 @@
+// Conformance suite for the grammar in docs/cli-design-principles.md.
+//
+// Every rule the parser implements has rows in a table of argv -> outcome,
+// and a differential test checks the parser against a small reference
+// model of the same grammar on generated command lines. Subcommands (§2,
+// §4), value options (§3.3, §3.4, §6.2) and help (§7) are not implemented
+// yet and have no rows.
+
+#include "mcli/mcli.hpp"
+#include "utils/args_builder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using mcli::define;
+using mcli::detail::parse::command_parser;
+using mcli::detail::parse::parse_error;
+using test::utils::argv_builder;
+using test::utils::make_argv;
+
+namespace
+{
+
+// Fixture schema:
+//   --verbose/-v  --dry-run/-n  --force
+//   <source> [<dest>] [<rest>...]  (rest only in the variadic schema)
+enum class schema
+{
+    fixed,
+    variadic,
+};
+
+struct Options
+{
+    bool verbose = false;
+    bool dry_run = false;
+    bool force = false;
+    std::string source;
+    std::string dest;
+    mcli::arg_range rest;
+};
+
+command_parser make_cli(Options& opts, schema kind)
+{
+    // clang-format off
+    auto builder = define();
+    builder
+        .flag()
+            .name("--verbose")
+            .abbr("-v")
+            .help("Enable verbose logging")
+            .bind(opts.verbose)
+        .flag()
+            .name("--dry-run")
+            .abbr("-n")
+            .help("Do not change anything")
+            .bind(opts.dry_run)
+        .flag()
+            .name("--force")
+            .help("Overwrite existing files")
+            .bind(opts.force)
+        .positional()
+            .name("source")
+            .help("Input")
+            .bind(opts.source)
+        .positional()
+            .name("dest")
+            .help("Output")
+            .optional()
+            .bind(opts.dest);
+    // clang-format on
+
+    if (kind == schema::variadic)
+    {
+        builder.positional().name("rest").help("Extra inputs").bind(opts.rest);
+    }
+    return builder.build();
+}
+
+// Compact, comparable summary of the parsed values.
+std::string describe(const Options& opts)
+{
+    std::string out;
+    if (opts.verbose)
+    {
+        out += "verbose ";
+    }
+    if (opts.dry_run)
+    {
+        out += "dry-run ";
+    }
+    if (opts.force)
+    {
+        out += "force ";
+    }
+    out += "source=" + opts.source + " dest=" + opts.dest + " rest=";
+    bool first = true;
+    for (auto arg : opts.rest)
+    {
+        if (!first)
+        {
+            out += ',';
+        }
+        out += arg;
+        first = false;
+    }
+    return out;
+}
+
+struct conformance_case
+{
+    std::string_view rule;  // section of cli-design-principles.md
+    schema kind;
+    std::vector<std::string> args;
+    parse_error error;
+    std::string_view expected;  // describe() on success
+};
+
+// clang-format off
+const std::vector<conformance_case> cases{
+    // §3.1 Long names and short aliases.
+    {"3.1 long name", schema::fixed,
+        {"app", "--verbose", "a"}, parse_error::none,
+        "verbose source=a dest= rest="},
+    {"3.1 short alias", schema::fixed,
+        {"app", "-v", "-n", "a"}, parse_error::none,
+        "verbose dry-run source=a dest= rest="},
+    {"3.1 alias is optional", schema::fixed,
+        {"app", "--force", "a"}, parse_error::none,
+        "force source=a dest= rest="},
+    {"3.1 names are case-sensitive", schema::fixed,
+        {"app", "--Verbose", "a"}, parse_error::unknown_option, ""},
+    {"3.1 kebab-case only", schema::fixed,
+        {"app", "--dry_run", "a"}, parse_error::unknown_option, ""},
+    {"3.1 no single-dash long names", schema::fixed,
+        {"app", "-verbose", "a"}, parse_error::unknown_option, ""},
+
+    // §3.2 Presence-only flags, duplicates are errors.
+    {"3.2 absent flag stays false", schema::fixed,
+        {"app", "a"}, parse_error::none,
+        "source=a dest= rest="},
+    {"3.2 no inline flag value", schema::fixed,
+        {"app", "--verbose=true", "a"}, parse_error::unknown_option, ""},
+    {"3.2 duplicate long", schema::fixed,
+        {"app", "--verbose", "--verbose", "a"},
+        parse_error::duplicate_option, ""},
+    {"3.2 duplicate via alias", schema::fixed,
+        {"app", "--verbose", "a", "-v"}, parse_error::duplicate_option, ""},
+
+    // §3.3 No POSIX clusters or attached values.
+    {"3.3 no short clusters", schema::fixed,
+        {"app", "-vn", "a"}, parse_error::unknown_option, ""},
+    {"3.3 no attached suffix", schema::fixed,
+        {"app", "--verbosetrue", "a"}, parse_error::unknown_option, ""},
+
+    // §5 Positionals, "--" terminator and the variadic tail.
+    {"5 required positional", schema::fixed,
+        {"app", "-v"}, parse_error::missing_positional, ""},
+    {"5 optional positional", schema::fixed,
+        {"app", "a", "b"}, parse_error::none,
+        "source=a dest=b rest="},
+    {"5 options between positionals", schema::fixed,
+        {"app", "a", "-v", "b", "--force"}, parse_error::none,
+        "verbose force source=a dest=b rest="},
+    {"5 too many positionals", schema::fixed,
+        {"app", "a", "b", "c"}, parse_error::unexpected_positional, ""},
+    {"5 lone dash is positional", schema::fixed,
+        {"app", "-"}, parse_error::none,
+        "source=- dest= rest="},
+    {"5 negative numbers are positionals", schema::fixed,
+        {"app", "-5", "-2.5"}, parse_error::none,
+        "source=-5 dest=-2.5 rest="},
+    {"5 dash-digit-letter is an option", schema::fixed,
+        {"app", "-5x", "a"}, parse_error::unknown_option, ""},
+    {"5 variadic keeps negative numbers", schema::variadic,
+        {"app", "a", "b", "-1", "-v", "c"}, parse_error::none,
+        "verbose source=a dest=b rest=-1,c"},
+    {"5 empty token is ignored", schema::fixed,
+        {"app", "", "a"}, parse_error::none,
+        "source=a dest= rest="},
+    {"5 terminator ends options", schema::fixed,
+        {"app", "--", "-v", "--force"}, parse_error::none,
+        "source=-v dest=--force rest="},
+    {"5 only the first terminator is special", schema::fixed,
+        {"app", "a", "--", "--"}, parse_error::none,
+        "source=a dest=-- rest="},
+    {"5 empty token after terminator", schema::fixed,
+        {"app", "a", "--", ""}, parse_error::none,
+        "source=a dest= rest="},
+    {"5 options still checked before terminator", schema::fixed,
+        {"app", "--bogus", "--", "a"}, parse_error::unknown_option, ""},
+    {"5 variadic takes the rest", schema::variadic,
+        {"app", "a", "b", "c", "d"}, parse_error::none,
+        "source=a dest=b rest=c,d"},
+    {"5 variadic may be empty", schema::variadic,
+        {"app", "a"}, parse_error::none,
+        "source=a dest= rest="},
+    {"5 variadic skips options", schema::variadic,
+        {"app", "a", "b", "c", "-v", "d"}, parse_error::none,
+        "verbose source=a dest=b rest=c,d"},
+    {"5 variadic after terminator", schema::variadic,
+        {"app", "a", "b", "c", "--", "-weird", "--"}, parse_error::none,
+        "source=a dest=b rest=c,-weird,--"},
+
+    // §6 Strict errors.
+    {"6.1 unknown long option", schema::fixed,
+        {"app", "--verbos", "a"}, parse_error::unknown_option, ""},
+    {"6.1 unknown short option", schema::fixed,
+        {"app", "-x", "a"}, parse_error::unknown_option, ""},
+    {"6.3 duplicate short", schema::fixed,
+        {"app", "-n", "-n", "a"}, parse_error::duplicate_option, ""},
+};
+// clang-format on
+
+class Conformance : public ::testing::TestWithParam<conformance_case>
+{
+};
+
+// Straightforward model of the grammar, written independently of the
+// parser: no indexes, no lazy ranges, no early exits beyond the rules.
+struct reference_result
+{
+    parse_error error{parse_error::none};
+    std::string expected;
+};
+
+// "-" followed by digits with at most one '.', e.g. "-5" or "-2.5".
+bool is_negative_number(const std::string& tok)
+{
+    if (tok.size() < 2 || tok[0] != '-' ||
+        std::count(tok.begin(), tok.end(), '.') > 1)
+    {
+        return false;
+    }
+    const std::string digits = tok.substr(1);
+    return digits.find_first_not_of("0123456789.") == std::string::npos &&
+           digits.find_first_of("0123456789") != std::string::npos;
+}
+
+reference_result reference_parse(const std::vector<std::string>& args,
+                                 schema kind)
+{
+    constexpr std::array<std::string_view, 3> longs{
+            "--verbose", "--dry-run", "--force"};
+    constexpr std::array<std::string_view, 3> shorts{"-v", "-n", ""};
+
+    std::array<bool, 3> seen{};
+    std::vector<std::string> positionals;
+    std::vector<std::string> rest;
+    bool terminated = false;
+
+    for (std::size_t i = 1; i < args.size(); ++i)
+    {
+        const std::string& tok = args[i];
+        if (!terminated)
+        {
+            if (tok == "--")
+            {
+                terminated = true;
+                continue;
+            }
+            if (tok.empty())
+            {
+                continue;
+            }
+            if (tok.size() > 1 && tok[0] == '-' && !is_negative_number(tok))
+            {
+                std::optional<std::size_t> match;
+                for (std::size_t f = 0; f < longs.size(); ++f)
+                {
+                    if (tok == longs[f] || (!shorts[f].empty() &&
+                                            tok == shorts[f]))
+                    {
+                        match = f;
+                    }
+                }
+                if (!match)
+                {
+                    return {parse_error::unknown_option, ""};
+                }
+                if (seen[*match])
+                {
+                    return {parse_error::duplicate_option, ""};
+                }
+                seen[*match] = true;
+                continue;
+            }
+        }
+
+        if (positionals.size() < 2)
+        {
+            positionals.push_back(tok);
+        }
+        else if (kind == schema::variadic)
+        {
+            rest.push_back(tok);
+        }
+        else
+        {
+            return {parse_error::unexpected_positional, ""};
+        }
+    }
+
+    if (positionals.empty())
+    {
+        return {parse_error::missing_positional, ""};
+    }
+
+    Options opts;
+    opts.verbose = seen[0];
+    opts.dry_run = seen[1];
+    opts.force = seen[2];
+    opts.source = positionals[0];
+    opts.dest = positionals.size() > 1 ? positionals[1] : "";
+    std::string out = describe(opts);
+    for (std::size_t i = 0; i < rest.size(); ++i)
+    {
+        out += (i == 0 ? "" : ",") + rest[i];
+    }
+    return {parse_error::none, out};
+}
+
+}  // namespace
+
+TEST_P(Conformance, Rule)
+{
+    const auto& test_case = GetParam();
+    SCOPED_TRACE(test_case.rule);
+
+    Options opts;
+    auto cli = make_cli(opts, test_case.kind);
+
+    const auto [argc, argv] = make_argv(test_case.args);
+    auto result = cli.parse(argc, argv);
+
+    EXPECT_EQ(result.error_code(), test_case.error)
+            << result.error_message();
+    if (test_case.error == parse_error::none)
+    {
+        EXPECT_EQ(describe(opts), test_case.expected);
+    }
+
+    // The reference model must agree with every table row.
+    auto reference = reference_parse(test_case.args, test_case.kind);
+    EXPECT_EQ(reference.error, test_case.error);
+    if (test_case.error == parse_error::none)
+    {
+        EXPECT_EQ(reference.expected, test_case.expected);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Grammar, Conformance, ::testing::ValuesIn(cases));
+
+TEST(ConformanceDifferential, MatchesReferenceModel)
+{
+    const std::array<std::string, 15> vocabulary{
+            "--verbose", "-v", "--dry-run", "-n", "--force", "--verbos",
+            "-vn",       "--", "",          "-",  "a",       "b",
+            "c",         "--x=1", "-1"};
+
+    // Fixed seed: failures are reproducible from the printed command line.
+    std::mt19937 rng{20240601};
+    std::uniform_int_distribution<std::size_t> length{0, 7};
+    std::uniform_int_distribution<std::size_t> pick{0, vocabulary.size() - 1};
+
+    for (int round = 0; round < 4000; ++round)
+    {
+        const auto kind = round % 2 == 0 ? schema::fixed : schema::variadic;
+
+        std::vector<std::string> args{"app"};
+        for (std::size_t n = length(rng); n > 0; --n)
+        {
+            args.push_back(vocabulary[pick(rng)]);
+        }
+
+        std::string line;
+        for (const auto& arg : args)
+        {
+            line += '"' + arg + "\" ";
+        }
+        SCOPED_TRACE(line);
+
+        Options opts;
+        auto cli = make_cli(opts, kind);
+        const auto [argc, argv] = make_argv(args);
+        auto result = cli.parse(argc, argv);
+
+        auto reference = reference_parse(args, kind);
+        ASSERT_EQ(result.error_code(), reference.error);
+        if (reference.error == parse_error::none)
+        {
+            ASSERT_EQ(describe(opts), reference.expected);
+        }
+    }
+}
+
+TEST(ConformanceThreads, ArgvBuildersAreIndependent)
+{
+    constexpr int thread_count = 8;
+    constexpr int rounds = 200;
+    std::array<int, thread_count> failures{};
+
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back(
+                    [t, &failures]
+                    {
+                        for (int round = 0; round < rounds; ++round)
+                        {
+                            Options opts;
+                            auto cli = make_cli(opts, schema::variadic);
+
+                            const std::string source =
+                                    "src-" + std::to_string(t);
+                            argv_builder args{{"app", source}};
+                            args.add("-v").add("dst").add(
+                                    std::to_string(round));
+
+                            auto result = cli.parse(args.argc(), args.argv());
+                            if (!result || opts.source != source ||
+                                opts.dest != "dst" || !opts.verbose ||
+                                describe(opts) !=
+                                        "verbose source=" + source +
+                                                " dest=dst rest=" +
+                                                std::to_string(round))
+                            {
+                                ++failures[static_cast<std::size_t>(t)];
+                            }
+                        }
+                    });
+        }
+    }
+
+    for (int t = 0; t < thread_count; ++t)
+    {
+        EXPECT_EQ(failures[static_cast<std::size_t>(t)], 0) << "thread " << t;
+    }
+}
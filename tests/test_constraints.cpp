@@ -0,0 +1,275 @@
+#include "mcli/mcli.hpp"
+#include "utils/args_builder.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+using mcli::define;
+using mcli::detail::parse::parse_error;
+using test::utils::make_argv;
+
+namespace
+{
+
+struct Options
+{
+    bool dry_run = false;
+    bool force = false;
+    bool tls_cert = false;
+    bool tls_key = false;
+    bool json = false;
+    bool yaml = false;
+};
+
+}  // namespace
+
+TEST(Constraints, ConflictsAcceptsEitherOption)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--dry-run")
+            .help("Do not perform changes")
+            .bind(opts.dry_run)
+        .flag()
+            .name("--force")
+            .help("Overwrite existing files")
+            .bind(opts.force)
+        .conflicts("--dry-run", "--force")
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app", "--force"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_TRUE(result);
+    EXPECT_TRUE(opts.force);
+}
+
+TEST(Constraints, ConflictsRejectsBoth)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--dry-run")
+            .help("Do not perform changes")
+            .bind(opts.dry_run)
+        .flag()
+            .name("--force")
+            .help("Overwrite existing files")
+            .bind(opts.force)
+        .conflicts("dry-run", "force")
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app", "--force", "--dry-run"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error_code(), parse_error::conflicting_options);
+    EXPECT_EQ("Conflicting options: --dry-run and --force",
+              std::string{result.error_message()});
+}
+
+TEST(Constraints, RequiresOption)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--tls-cert")
+            .help("Use a TLS certificate")
+            .bind(opts.tls_cert)
+        .flag()
+            .name("--tls-key")
+            .help("Use a TLS key")
+            .bind(opts.tls_key)
+        .requires_option("--tls-cert", "--tls-key")
+        .build();
+    // clang-format on
+
+    {
+        const auto [argc, argv] = make_argv({"app", "--tls-cert"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error_code(), parse_error::missing_required_option);
+        EXPECT_EQ("Option --tls-cert requires --tls-key",
+                  std::string{result.error_message()});
+    }
+    {
+        const auto [argc, argv] = make_argv({"app", "--tls-key"});
+        EXPECT_TRUE(cli.parse(argc, argv));
+    }
+    {
+        const auto [argc, argv] =
+                make_argv({"app", "--tls-key", "--tls-cert"});
+        EXPECT_TRUE(cli.parse(argc, argv));
+    }
+}
+
+TEST(Constraints, OneOf)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--json")
+            .help("Print JSON")
+            .bind(opts.json)
+        .flag()
+            .name("--yaml")
+            .help("Print YAML")
+            .bind(opts.yaml)
+        .one_of({"--json", "--yaml"})
+        .build();
+    // clang-format on
+
+    {
+        const auto [argc, argv] = make_argv({"app"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error_code(), parse_error::missing_one_of);
+        EXPECT_EQ("Missing one of: --json, --yaml",
+                  std::string{result.error_message()});
+
+        std::array<char, 256> buffer{};
+        const auto size = mcli::detail::parse::render_json(
+                result.diagnostics().front(), cli.schema(), buffer);
+        EXPECT_NE(std::string_view(buffer.data(), size)
+                          .find("\"options\":[\"--json\",\"--yaml\"]"),
+                  std::string_view::npos);
+    }
+    {
+        const auto [argc, argv] = make_argv({"app", "--yaml", "--json"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error_code(), parse_error::conflicting_options);
+    }
+    {
+        const auto [argc, argv] = make_argv({"app", "--json"});
+        EXPECT_TRUE(cli.parse(argc, argv));
+    }
+}
+
+TEST(Constraints, ManyOptionsSpanSeveralWords)
+{
+    constexpr std::size_t count = 130;
+    std::array<bool, count> values{};
+
+    auto builder = define();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        builder.flag()
+                .name("--opt-" + std::to_string(i))
+                .help("Generated option")
+                .bind(values.at(i));
+    }
+    builder.mutually_exclusive({"--opt-1", "--opt-70", "--opt-129"});
+    builder.requires_option("--opt-0", "--opt-128");
+    auto cli = builder.build();
+
+    {
+        const auto [argc, argv] = make_argv({"app", "--opt-1", "--opt-129"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_FALSE(result);
+        EXPECT_EQ("Conflicting options: --opt-1 and --opt-129",
+                  std::string{result.error_message()});
+    }
+    {
+        const auto [argc, argv] = make_argv({"app", "--opt-0", "--opt-128"});
+        EXPECT_TRUE(cli.parse(argc, argv));
+    }
+}
+
+TEST(Constraints, AliasesNameOptions)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--dry-run")
+            .abbr("-n")
+            .help("Do not perform changes")
+            .bind(opts.dry_run)
+        .flag()
+            .name("force")
+            .abbr("f")
+            .help("Overwrite existing files")
+            .bind(opts.force)
+        .conflicts("-n", "force")
+        .requires_option("-f", "--dry-run")
+        .build();
+    // clang-format on
+
+    {
+        const auto [argc, argv] = make_argv({"app", "--dry-run", "--force"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error_code(), parse_error::conflicting_options);
+    }
+    {
+        const auto [argc, argv] = make_argv({"app", "-f"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error_code(), parse_error::missing_required_option);
+    }
+}
+
+#ifndef NDEBUG
+TEST(ConstraintsDeathTest, UnknownOptionIsRejectedAtBuild)
+{
+    Options opts;
+
+    EXPECT_DEATH(
+            {
+                // clang-format off
+                auto cli = define()
+                    .flag()
+                        .name("--force")
+                        .help("Overwrite existing files")
+                        .bind(opts.force)
+                    .requires_option("--forse", "--force")
+                    .build();
+                // clang-format on
+                static_cast<void>(cli);
+            },
+            "constraint refers to an unknown option");
+}
+#else
+TEST(Constraints, UnknownOptionDropsConstraint)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--force")
+            .help("Overwrite existing files")
+            .bind(opts.force)
+        .requires_option("--forse", "--force")
+        .one_of({"--force", "--jsno"})
+        .build();
+    // clang-format on
+
+    EXPECT_TRUE(cli.schema().constraints().empty());
+
+    const auto [argc, argv] = make_argv({"app"});
+    EXPECT_TRUE(cli.parse(argc, argv));
+}
+
+TEST(Constraints, UnknownOptionWithoutOptions)
+{
+    auto cli = define().conflicts("--a", "--b").build();
+    EXPECT_TRUE(cli.schema().constraints().empty());
+}
+#endif
@@ -0,0 +1,356 @@
+#include "mcli/mcli.hpp"
+#include "utils/args_builder.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using mcli::define;
+using mcli::value_source;
+using mcli::detail::parse::parse_error;
+using mcli::detail::spec::flag_descriptor;
+using test::utils::make_argv;
+
+namespace
+{
+
+struct Options
+{
+    bool color = false;
+    bool verbose = false;
+    bool dry_run = true;
+};
+
+// Sets an environment variable for the lifetime of the guard.
+class scoped_env
+{
+public:
+    scoped_env(const char* name, const char* value) : m_name{name}
+    {
+#if defined(_WIN32)
+        ::_putenv_s(name, value);
+#else
+        ::setenv(name, value, 1);
+#endif
+    }
+
+    scoped_env(const scoped_env&) = delete;
+    scoped_env& operator=(const scoped_env&) = delete;
+
+    ~scoped_env()
+    {
+#if defined(_WIN32)
+        // An empty value removes the variable.
+        ::_putenv_s(m_name, "");
+#else
+        ::unsetenv(m_name);
+#endif
+    }
+
+private:
+    const char* m_name;
+};
+
+}  // namespace
+
+TEST(Defaults, AppliedAtBuild)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--color")
+            .help("Colorize output")
+            .default_value(true)
+            .bind(opts.color)
+        .build();
+    // clang-format on
+
+    EXPECT_TRUE(opts.color);
+}
+
+TEST(Defaults, SourcesTrackDefaultAndCommandLine)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--color")
+            .help("Colorize output")
+            .default_value(true)
+            .bind(opts.color)
+        .flag()
+            .name("--verbose")
+            .help("Enable verbose logging")
+            .bind(opts.verbose)
+        .flag()
+            .name("--dry-run")
+            .help("Do not change anything")
+            .bind(opts.dry_run)
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app", "--verbose"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_TRUE(result);
+
+    ASSERT_EQ(result.sources().size(), 3U);
+    EXPECT_EQ(result.source(0), value_source::default_value);
+    EXPECT_EQ(result.source(1), value_source::command_line);
+    EXPECT_EQ(result.source(2), value_source::none);
+
+    EXPECT_FALSE(result.was_set(0));
+    EXPECT_TRUE(result.was_set(1));
+    EXPECT_FALSE(result.was_set(2));
+
+    // Without a declared default the caller's initial value is kept.
+    EXPECT_TRUE(opts.color);
+    EXPECT_TRUE(opts.verbose);
+    EXPECT_TRUE(opts.dry_run);
+}
+
+TEST(Defaults, ReappliedOnEveryParse)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--verbose")
+            .help("Enable verbose logging")
+            .default_value(false)
+            .bind(opts.verbose)
+        .build();
+    // clang-format on
+
+    {
+        const auto [argc, argv] = make_argv({"app", "--verbose"});
+        ASSERT_TRUE(cli.parse(argc, argv));
+        EXPECT_TRUE(opts.verbose);
+    }
+    {
+        const auto [argc, argv] = make_argv({"app"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_TRUE(result);
+        EXPECT_FALSE(opts.verbose);
+        EXPECT_EQ(result.source(0), value_source::default_value);
+    }
+}
+
+TEST(Defaults, FlagWithoutDefaultKeepsPreviousValue)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--verbose")
+            .help("Enable verbose logging")
+            .bind(opts.verbose)
+        .build();
+    // clang-format on
+
+    {
+        const auto [argc, argv] = make_argv({"app", "--verbose"});
+        ASSERT_TRUE(cli.parse(argc, argv));
+    }
+
+    // Only declared defaults are rewritten; reset the variable yourself or
+    // declare default_value(false) to start each parse from false.
+    const auto [argc, argv] = make_argv({"app"});
+    auto result = cli.parse(argc, argv);
+    ASSERT_TRUE(result);
+    EXPECT_TRUE(opts.verbose);
+    EXPECT_EQ(result.source(0), value_source::none);
+}
+
+TEST(Defaults, EnvironmentOverridesDefault)
+{
+    Options opts;
+    scoped_env env{"MCLI_TEST_COLOR", "off"};
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--color")
+            .help("Colorize output")
+            .default_value(true)
+            .env("MCLI_TEST_COLOR")
+            .bind(opts.color)
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_TRUE(result);
+    EXPECT_FALSE(opts.color);
+    EXPECT_EQ(result.source(0), value_source::environment);
+    EXPECT_TRUE(result.was_set(0));
+}
+
+TEST(Defaults, EnvironmentViolationIgnoresTokensAfterTerminator)
+{
+    Options opts;
+    std::string file;
+    scoped_env env{"MCLI_TEST_VERBOSE", "1"};
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--verbose")
+            .help("Enable verbose logging")
+            .env("MCLI_TEST_VERBOSE")
+            .bind(opts.verbose)
+        .flag()
+            .name("--dry-run")
+            .help("Do not perform changes")
+            .bind(opts.dry_run)
+        .positional()
+            .name("file")
+            .help("Input file")
+            .bind(file)
+        .requires_option("--verbose", "--dry-run")
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app", "--", "--verbose"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(file, "--verbose");
+
+    // --verbose came from the environment; the token after "--" is a file.
+    const auto& diag = result.diagnostics().front();
+    EXPECT_EQ(diag.code, parse_error::missing_required_option);
+    EXPECT_EQ(diag.token_index, mcli::detail::parse::diagnostic::npos);
+}
+
+TEST(Defaults, CommandLineOverridesEnvironment)
+{
+    Options opts;
+    scoped_env env{"MCLI_TEST_VERBOSE", "0"};
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--verbose")
+            .help("Enable verbose logging")
+            .env("MCLI_TEST_VERBOSE")
+            .bind(opts.verbose)
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app", "--verbose"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_TRUE(result);
+    EXPECT_TRUE(opts.verbose);
+    EXPECT_EQ(result.source(0), value_source::command_line);
+}
+
+TEST(Defaults, FalseFromEnvironmentDoesNotTriggerConstraints)
+{
+    Options opts;
+    scoped_env env{"MCLI_TEST_FORCE", "0"};
+    bool force = false;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--dry-run")
+            .help("Do not change anything")
+            .bind(opts.dry_run)
+        .flag()
+            .name("--force")
+            .help("Overwrite existing files")
+            .env("MCLI_TEST_FORCE")
+            .bind(force)
+        .conflicts("--dry-run", "--force")
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app", "--dry-run"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_TRUE(result) << result.error_message();
+    EXPECT_FALSE(force);
+    EXPECT_EQ(result.source(1), value_source::environment);
+}
+
+TEST(Defaults, TrueFromEnvironmentTriggersConstraints)
+{
+    Options opts;
+    scoped_env env{"MCLI_TEST_FORCE", "1"};
+    bool force = false;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--dry-run")
+            .help("Do not change anything")
+            .bind(opts.dry_run)
+        .flag()
+            .name("--force")
+            .help("Overwrite existing files")
+            .env("MCLI_TEST_FORCE")
+            .bind(force)
+        .conflicts("--dry-run", "--force")
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app", "--dry-run"});
+
+    auto result = cli.parse(argc, argv);
+    EXPECT_EQ(result.error_code(), parse_error::conflicting_options);
+}
+
+TEST(Defaults, InvalidEnvironmentValue)
+{
+    Options opts;
+    scoped_env env{"MCLI_TEST_VERBOSE", "maybe"};
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--verbose")
+            .help("Enable verbose logging")
+            .env("MCLI_TEST_VERBOSE")
+            .bind(opts.verbose)
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error_code(), parse_error::invalid_value);
+    EXPECT_EQ(result.error_message(), "Invalid value for --verbose: maybe");
+    EXPECT_EQ(result.source(0), value_source::none);
+}
+
+TEST(Defaults, BulkDescriptorDefaults)
+{
+    auto values = std::make_unique<bool[]>(2);
+    std::vector<flag_descriptor> descriptors{
+            {"alpha", "", "First", &values[0], true},
+            {"beta", "", "Second", &values[1]},
+    };
+
+    auto cli = define().flags(descriptors).build();
+    EXPECT_TRUE(values[0]);
+    EXPECT_FALSE(values[1]);
+
+    const auto [argc, argv] = make_argv({"app", "--beta"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.source(0), value_source::default_value);
+    EXPECT_EQ(result.source(1), value_source::command_line);
+}
@@ -0,0 +1,176 @@
+#include "mcli/mcli.hpp"
+#include "utils/args_builder.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+using mcli::define;
+using mcli::detail::parse::parse_error;
+using mcli::detail::parse::parse_options;
+using test::utils::make_argv;
+
+namespace
+{
+
+struct Options
+{
+    bool verbose = false;
+    bool dry_run = false;
+    bool force = false;
+};
+
+auto make_cli(Options& opts)
+{
+    // clang-format off
+    return define()
+        .flag()
+            .name("--verbose")
+            .abbr("-v")
+            .help("Enable verbose logging")
+            .bind(opts.verbose)
+        .flag()
+            .name("--dry-run")
+            .abbr("-n")
+            .help("Do not perform changes")
+            .bind(opts.dry_run)
+        .flag()
+            .name("--force")
+            .help("Overwrite existing files")
+            .bind(opts.force)
+        .conflicts("--dry-run", "--force")
+        .build();
+    // clang-format on
+}
+
+}  // namespace
+
+TEST(Diagnostics, UnknownOptionCarriesSpanAndSuggestion)
+{
+    Options opts;
+    auto cli = make_cli(opts);
+
+    const auto [argc, argv] = make_argv({"app", "-v", "--verbos"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_FALSE(result);
+    ASSERT_EQ(result.diagnostics().size(), 1U);
+
+    const auto& diag = result.diagnostics().front();
+    EXPECT_EQ(diag.code, parse_error::unknown_option);
+    EXPECT_EQ(diag.token_index, 2U);
+    EXPECT_EQ(diag.token, "--verbos");
+    EXPECT_EQ(diag.byte_begin, 7U);  // "app -v "
+    EXPECT_EQ(diag.byte_end, 15U);
+    ASSERT_EQ(diag.suggestions().size(), 1U);
+    EXPECT_EQ(cli.schema().option_name(diag.suggestions()[0]), "--verbose");
+
+    EXPECT_EQ("Unknown option: --verbos (did you mean --verbose?)",
+              std::string{result.error_message()});
+}
+
+TEST(Diagnostics, ConstraintViolationPointsAtOptions)
+{
+    Options opts;
+    auto cli = make_cli(opts);
+
+    const auto [argc, argv] = make_argv({"app", "--force", "-n"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_FALSE(result);
+
+    const auto& diag = result.diagnostics().front();
+    EXPECT_EQ(diag.code, parse_error::conflicting_options);
+    EXPECT_EQ(cli.schema().option_name(diag.slot), "--dry-run");
+    EXPECT_EQ(cli.schema().option_name(diag.related_slot), "--force");
+    EXPECT_EQ(diag.token_index, 1U);
+    EXPECT_EQ(diag.token, "--force");
+}
+
+TEST(Diagnostics, ConstraintViolationSkipsEmptyTokens)
+{
+    Options opts;
+    auto cli = make_cli(opts);
+
+    // --force has no abbreviation, so "" must not match it.
+    const auto [argc, argv] = make_argv({"app", "", "--force", "-n"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_FALSE(result);
+
+    const auto& diag = result.diagnostics().front();
+    EXPECT_EQ(diag.code, parse_error::conflicting_options);
+    EXPECT_EQ(diag.token_index, 2U);
+    EXPECT_EQ(diag.token, "--force");
+    EXPECT_EQ(diag.byte_begin, 5U);  // "app  "
+}
+
+TEST(Diagnostics, CollectAllReportsEveryError)
+{
+    Options opts;
+    auto cli = make_cli(opts);
+
+    const auto [argc, argv] =
+            make_argv({"app", "--bogus", "-n", "-n", "--force", "-x"});
+
+    parse_options options;
+    options.collect_all = true;
+    options.format_message = false;
+
+    auto result = cli.parse(argc, argv, options);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error_code(), parse_error::unknown_option);
+    EXPECT_TRUE(result.error_message().empty());
+
+    auto diags = result.diagnostics();
+    ASSERT_EQ(diags.size(), 4U);
+    EXPECT_EQ(diags[0].code, parse_error::unknown_option);
+    EXPECT_EQ(diags[1].code, parse_error::duplicate_option);
+    EXPECT_EQ(diags[1].token_index, 3U);
+    EXPECT_EQ(diags[2].code, parse_error::unknown_option);
+    EXPECT_EQ(diags[2].token, "-x");
+    EXPECT_EQ(diags[3].code, parse_error::conflicting_options);
+}
+
+TEST(Diagnostics, RenderersWriteIntoCallerBuffer)
+{
+    using mcli::detail::parse::render_ansi;
+    using mcli::detail::parse::render_json;
+    using mcli::detail::parse::render_text;
+
+    Options opts;
+    auto cli = make_cli(opts);
+
+    const auto [argc, argv] = make_argv({"app", "--forc\"e"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_FALSE(result);
+    const auto& diag = result.diagnostics().front();
+
+    std::array<char, 256> buffer{};
+
+    auto size = render_text(diag, cli.schema(), buffer);
+    EXPECT_EQ(std::string_view(buffer.data(), size),
+              "Unknown option: --forc\"e (did you mean --force?)");
+
+    size = render_ansi(diag, cli.schema(), buffer);
+    EXPECT_EQ(std::string_view(buffer.data(), size),
+              "\x1b[1;31mUnknown option:\x1b[0m \x1b[1m--forc\"e\x1b[0m "
+              "(did you mean \x1b[32m--force\x1b[0m?)");
+
+    size = render_json(diag, cli.schema(), buffer);
+    EXPECT_EQ(std::string_view(buffer.data(), size),
+              "{\"code\":\"unknown_option\",\"token_index\":1,"
+              "\"token\":\"--forc\\\"e\",\"begin\":4,\"end\":12,"
+              "\"option\":null,\"related_option\":null,"
+              "\"positional\":null,\"options\":[],"
+              "\"suggestions\":[\"--force\"]}");
+
+    // A short buffer truncates but still reports the full size.
+    std::array<char, 8> small{};
+    EXPECT_EQ(render_text(diag, cli.schema(), small),
+              render_text(diag, cli.schema(), buffer));
+    EXPECT_EQ(std::string_view(small.data(), small.size()), "Unknown ");
+}
@@ -0,0 +1,213 @@
+#include "mcli/mcli.hpp"
+#include "utils/args_builder.hpp"
+
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using mcli::define;
+using mcli::detail::parse::parse_error;
+using test::utils::make_argv;
+
+namespace
+{
+
+struct Options
+{
+    bool verbose = false;
+    std::string source;
+    std::string dest;
+    int port = 0;
+    mcli::arg_range paths;
+};
+
+static_assert(std::ranges::forward_range<mcli::arg_range>);
+
+std::vector<std::string_view> collect(const mcli::arg_range& range)
+{
+    return {range.begin(), range.end()};
+}
+
+}  // namespace
+
+TEST(Positionals, FixedAndOptional)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--verbose")
+            .help("Enable verbose logging")
+            .bind(opts.verbose)
+        .positional()
+            .name("source")
+            .help("File to copy")
+            .bind(opts.source)
+        .positional()
+            .name("dest")
+            .help("Destination")
+            .optional()
+            .bind(opts.dest)
+        .build();
+    // clang-format on
+
+    {
+        const auto [argc, argv] = make_argv({"app", "a.txt", "--verbose"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(opts.source, "a.txt");
+        EXPECT_TRUE(opts.dest.empty());
+        EXPECT_TRUE(opts.verbose);
+    }
+    {
+        const auto [argc, argv] = make_argv({"app", "a.txt", "b.txt"});
+        ASSERT_TRUE(cli.parse(argc, argv));
+        EXPECT_EQ(opts.dest, "b.txt");
+    }
+}
+
+TEST(Positionals, MissingAndUnexpected)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .positional()
+            .name("source")
+            .help("File to copy")
+            .bind(opts.source)
+        .build();
+    // clang-format on
+
+    {
+        const auto [argc, argv] = make_argv({"app"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error_code(), parse_error::missing_positional);
+        EXPECT_EQ("Missing argument: <source>",
+                  std::string{result.error_message()});
+    }
+    {
+        const auto [argc, argv] = make_argv({"app", "a", "b"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error_code(), parse_error::unexpected_positional);
+        EXPECT_EQ(result.diagnostics().front().token_index, 2U);
+        EXPECT_EQ("Unexpected argument: b",
+                  std::string{result.error_message()});
+    }
+}
+
+TEST(Positionals, TypedValue)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .positional()
+            .name("port")
+            .help("Port to listen on")
+            .bind(opts.port)
+        .build();
+    // clang-format on
+
+    {
+        const auto [argc, argv] = make_argv({"app", "8080"});
+        ASSERT_TRUE(cli.parse(argc, argv));
+        EXPECT_EQ(opts.port, 8080);
+    }
+    {
+        const auto [argc, argv] = make_argv({"app", "80x"});
+        auto result = cli.parse(argc, argv);
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error_code(), parse_error::invalid_value);
+        EXPECT_EQ("Invalid value for <port>: 80x",
+                  std::string{result.error_message()});
+    }
+}
+
+TEST(Positionals, NegativeNumberIsValue)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--verbose")
+            .abbr("-v")
+            .help("Enable verbose logging")
+            .bind(opts.verbose)
+        .positional()
+            .name("port")
+            .help("Port to listen on")
+            .bind(opts.port)
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app", "-v", "-5"});
+    auto result = cli.parse(argc, argv);
+    ASSERT_TRUE(result) << result.error_message();
+    EXPECT_TRUE(opts.verbose);
+    EXPECT_EQ(opts.port, -5);
+}
+
+TEST(Positionals, VariadicIsViewOverArgv)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--verbose")
+            .abbr("-v")
+            .help("Enable verbose logging")
+            .bind(opts.verbose)
+        .positional()
+            .name("source")
+            .help("File to copy")
+            .bind(opts.source)
+        .positional()
+            .name("paths")
+            .help("Files to process")
+            .bind(opts.paths)
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv(
+            {"app", "src", "a", "-v", "", "b", "--", "-c", "--", "d"});
+
+    auto result = cli.parse(argc, argv);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(opts.source, "src");
+    EXPECT_TRUE(opts.verbose);
+
+    auto paths = collect(opts.paths);
+    EXPECT_EQ(paths,
+              (std::vector<std::string_view>{"a", "b", "-c", "--", "d"}));
+
+    // Elements are views into argv, not copies.
+    EXPECT_EQ(paths.front().data(), argv[2]);
+}
+
+TEST(Positionals, EmptyVariadic)
+{
+    Options opts;
+
+    // clang-format off
+    auto cli = define()
+        .positional()
+            .name("paths")
+            .help("Files to process")
+            .bind(opts.paths)
+        .build();
+    // clang-format on
+
+    const auto [argc, argv] = make_argv({"app", "--"});
+
+    ASSERT_TRUE(cli.parse(argc, argv));
+    EXPECT_TRUE(opts.paths.empty());
+}
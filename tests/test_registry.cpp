@@ -0,0 +1,318 @@
+#include "mcli/registry.hpp"
+#include "utils/args_builder.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using mcli::define;
+using mcli::schema_registry;
+using mcli::detail::parse::command_parser;
+using mcli::detail::parse::parse_error;
+using test::utils::make_argv;
+
+namespace
+{
+
+struct Options
+{
+    bool verbose = false;
+    bool quiet = false;
+};
+
+command_parser make_verbose_cli(Options& opts)
+{
+    // clang-format off
+    return define()
+        .flag()
+            .name("--verbose")
+            .abbr("-v")
+            .help("Enable verbose logging")
+            .bind(opts.verbose)
+        .build();
+    // clang-format on
+}
+
+command_parser make_quiet_cli(Options& opts)
+{
+    // clang-format off
+    return define()
+        .flag()
+            .name("--quiet")
+            .abbr("-q")
+            .help("Suppress output")
+            .bind(opts.quiet)
+        .build();
+    // clang-format on
+}
+
+}  // namespace
+
+TEST(Registry, PublishAndParseByName)
+{
+    Options opts;
+    schema_registry registry;
+
+    EXPECT_EQ(registry.publish("tool", make_verbose_cli(opts)), 1U);
+    EXPECT_EQ(registry.size(), 1U);
+
+    const auto [argc, argv] = make_argv({"tool", "--verbose"});
+    auto result = registry.parse("tool", argc, argv);
+    ASSERT_TRUE(result);
+    EXPECT_TRUE(opts.verbose);
+
+    auto handle = registry.find("tool");
+    ASSERT_NE(handle, nullptr);
+    EXPECT_EQ(handle->name(), "tool");
+    EXPECT_EQ(handle->schema().option_name(0), "--verbose");
+}
+
+TEST(Registry, UnknownCommand)
+{
+    schema_registry registry;
+
+    const auto [argc, argv] = make_argv({"tool"});
+    auto result = registry.parse("tool", argc, argv);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error_code(), parse_error::unknown_command);
+    EXPECT_EQ(result.error_message(), "Unknown command: tool");
+    EXPECT_EQ(registry.find("tool"), nullptr);
+}
+
+TEST(Registry, HotSwapKeepsOldVersionAlive)
+{
+    Options old_opts;
+    Options new_opts;
+    schema_registry registry;
+
+    registry.publish("plugin", make_verbose_cli(old_opts));
+    auto in_flight = registry.find("plugin");
+
+    EXPECT_EQ(registry.publish("plugin", make_quiet_cli(new_opts)), 2U);
+    EXPECT_EQ(registry.size(), 1U);
+
+    // The handle taken before the swap still parses the old schema.
+    {
+        const auto [argc, argv] = make_argv({"plugin", "-v"});
+        ASSERT_TRUE(in_flight->parse(argc, argv));
+        EXPECT_TRUE(old_opts.verbose);
+        EXPECT_EQ(in_flight->version(), 1U);
+    }
+
+    // New lookups see the new one.
+    {
+        const auto [argc, argv] = make_argv({"plugin", "-v"});
+        auto result = registry.parse("plugin", argc, argv);
+        EXPECT_EQ(result.error_code(), parse_error::unknown_option);
+    }
+    {
+        const auto [argc, argv] = make_argv({"plugin", "-q"});
+        ASSERT_TRUE(registry.parse("plugin", argc, argv));
+        EXPECT_TRUE(new_opts.quiet);
+        EXPECT_EQ(registry.find("plugin")->version(), 2U);
+    }
+}
+
+TEST(Registry, RemoveKeepsHandlesValid)
+{
+    Options opts;
+    schema_registry registry;
+
+    registry.publish("tool", make_verbose_cli(opts));
+    auto handle = registry.find("tool");
+
+    EXPECT_TRUE(registry.remove("tool"));
+    EXPECT_FALSE(registry.remove("tool"));
+    EXPECT_EQ(registry.find("tool"), nullptr);
+    EXPECT_EQ(registry.size(), 0U);
+
+    const auto [argc, argv] = make_argv({"tool", "--verbose"});
+    ASSERT_TRUE(handle->parse(argc, argv));
+    EXPECT_TRUE(opts.verbose);
+}
+
+TEST(Registry, ManyTenants)
+{
+    constexpr std::size_t tenant_count = 500;
+    auto opts = std::make_unique<Options[]>(tenant_count);
+    schema_registry registry;
+
+    for (std::size_t i = 0; i < tenant_count; ++i)
+    {
+        registry.publish("tenant-" + std::to_string(i),
+                         make_verbose_cli(opts[i]));
+    }
+    EXPECT_EQ(registry.size(), tenant_count);
+
+    for (std::size_t i = 0; i < tenant_count; ++i)
+    {
+        auto handle = registry.find("tenant-" + std::to_string(i));
+        ASSERT_NE(handle, nullptr);
+        EXPECT_EQ(handle->name(), "tenant-" + std::to_string(i));
+    }
+}
+
+TEST(Registry, ConcurrentParsesDuringHotSwap)
+{
+    constexpr std::size_t tenant_count = 16;
+    constexpr int reader_count = 8;
+    constexpr int rounds = 500;
+
+    // Every version of every tenant binds its own storage, kept alive
+    // until the end of the test.
+    std::vector<std::unique_ptr<Options>> storage;
+    schema_registry registry;
+    for (std::size_t i = 0; i < tenant_count; ++i)
+    {
+        storage.push_back(std::make_unique<Options>());
+        registry.publish("tenant-" + std::to_string(i),
+                         make_verbose_cli(*storage.back()));
+    }
+
+    std::atomic<int> failures{0};
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < reader_count; ++t)
+        {
+            threads.emplace_back(
+                    [&registry, &failures, t]
+                    {
+                        for (int round = 0; round < rounds; ++round)
+                        {
+                            const auto tenant =
+                                    "tenant-" +
+                                    std::to_string(
+                                            static_cast<std::size_t>(
+                                                    t + round) %
+                                            tenant_count);
+                            const auto [argc, argv] =
+                                    make_argv({tenant, "--verbose"});
+                            if (!registry.parse(tenant, argc, argv))
+                            {
+                                failures.fetch_add(1);
+                            }
+                        }
+                    });
+        }
+
+        // Republish every tenant while the readers run.
+        for (int round = 0; round < 20; ++round)
+        {
+            for (std::size_t i = 0; i < tenant_count; ++i)
+            {
+                storage.push_back(std::make_unique<Options>());
+                registry.publish("tenant-" + std::to_string(i),
+                                 make_verbose_cli(*storage.back()));
+            }
+        }
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(registry.size(), tenant_count);
+    EXPECT_EQ(registry.find("tenant-0")->version(), 21U);
+}
+
+TEST(Registry, ReplacedVersionsAreReclaimedAfterReaders)
+{
+    constexpr int reader_count = 4;
+    constexpr int versions = 200;
+
+    std::vector<std::unique_ptr<Options>> storage;
+    std::vector<std::weak_ptr<const mcli::detail::registry::registered_schema>>
+            replaced;
+    schema_registry registry;
+
+    storage.push_back(std::make_unique<Options>());
+    registry.publish("tool", make_verbose_cli(*storage.back()));
+
+    std::atomic<bool> done{false};
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < reader_count; ++t)
+        {
+            threads.emplace_back(
+                    [&registry, &done]
+                    {
+                        while (!done.load())
+                        {
+                            static_cast<void>(registry.find("tool"));
+                        }
+                    });
+        }
+
+        // Tables replaced while readers are in flight cannot be freed at
+        // once; they must still be freed when their readers are gone.
+        for (int version = 1; version < versions; ++version)
+        {
+            replaced.push_back(registry.find("tool"));
+            storage.push_back(std::make_unique<Options>());
+            registry.publish("tool", make_verbose_cli(*storage.back()));
+        }
+        done.store(true);
+    }
+
+    // The last reader of a deferred table or the next lookup frees it.
+    static_cast<void>(registry.find("tool"));
+
+    for (const auto& old : replaced)
+    {
+        EXPECT_TRUE(old.expired());
+    }
+    EXPECT_EQ(registry.find("tool")->version(),
+              static_cast<std::uint64_t>(versions));
+}
+
+TEST(Registry, ParseLockedCoversReadingBoundValues)
+{
+    constexpr int thread_count = 4;
+    constexpr int rounds = 500;
+
+    Options opts;
+    schema_registry registry;
+
+    // clang-format off
+    registry.publish("tool", define()
+        .flag()
+            .name("--verbose")
+            .help("Enable verbose logging")
+            .default_value(false)
+            .bind(opts.verbose)
+        .build());
+    // clang-format on
+
+    std::atomic<int> mismatches{0};
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back(
+                    [&registry, &opts, &mismatches, t]
+                    {
+                        const bool verbose = t % 2 == 0;
+                        for (int round = 0; round < rounds; ++round)
+                        {
+                            const auto [argc, argv] =
+                                    verbose ? make_argv({"tool", "--verbose"})
+                                            : make_argv({"tool"});
+                            auto locked =
+                                    registry.parse_locked("tool", argc, argv);
+                            if (!locked.result || opts.verbose != verbose)
+                            {
+                                mismatches.fetch_add(1);
+                            }
+                        }
+                    });
+        }
+    }
+
+    EXPECT_EQ(mismatches.load(), 0);
+
+    const auto [argc, argv] = make_argv({"tool"});
+    auto missing = registry.parse_locked("other", argc, argv);
+    EXPECT_FALSE(missing.lock.owns_lock());
+    EXPECT_EQ(missing.result.error_code(), parse_error::unknown_command);
+}
@@ -0,0 +1,94 @@
+#include "mcli/mcli.hpp"
+#include "mcli/detail/utils/string_pool.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using mcli::define;
+using mcli::detail::utils::string_id;
+using mcli::detail::utils::string_pool;
+
+TEST(StringPoolTest, EqualStringsShareOneId)
+{
+    string_pool pool;
+
+    auto first = pool.intern("--verbose");
+    auto other = pool.intern("--dry-run");
+    auto again = pool.intern(std::string{"--verbose"});
+
+    EXPECT_EQ(first, again);
+    EXPECT_NE(first, other);
+    EXPECT_EQ(pool.view(first), "--verbose");
+    EXPECT_EQ(pool.view(other), "--dry-run");
+    EXPECT_EQ(pool.size(), 3U);  // "", "--verbose", "--dry-run"
+}
+
+TEST(StringPoolTest, EmptyStringIsDefaultId)
+{
+    string_pool pool;
+
+    EXPECT_TRUE(pool.intern("").empty());
+    EXPECT_EQ(pool.intern(""), string_id{});
+    EXPECT_EQ(pool.view(string_id{}), "");
+}
+
+TEST(StringPoolTest, IdsStayValidWhilePoolGrows)
+{
+    string_pool pool;
+    std::vector<string_id> ids;
+    for (int i = 0; i < 1000; ++i)
+    {
+        ids.push_back(pool.intern("name-" + std::to_string(i)));
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(pool.view(ids[i]), "name-" + std::to_string(i));
+        EXPECT_EQ(pool.find("name-" + std::to_string(i)), ids[i]);
+    }
+    EXPECT_FALSE(pool.find("name-1000").has_value());
+}
+
+TEST(StringPoolTest, InterningOwnViewIsSafe)
+{
+    string_pool pool;
+    auto id = pool.intern("--verbose");
+
+    // The view points into the pool's own buffer, which may reallocate.
+    for (int i = 0; i < 100; ++i)
+    {
+        pool.intern(pool.view(id).substr(0, 2 + (i % 7)));
+    }
+    EXPECT_EQ(pool.view(id), "--verbose");
+    EXPECT_EQ(pool.view(pool.intern("--verb")), "--verb");
+}
+
+TEST(StringPoolTest, SharedHelpTextIsStoredOnce)
+{
+    std::vector<std::string> names;
+    for (int i = 0; i < 100; ++i)
+    {
+        names.push_back("--flag-" + std::to_string(i));
+    }
+    auto values = std::make_unique<bool[]>(names.size());
+
+    auto builder = define();
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        builder.flag()
+                .name(names[i])
+                .help("Shared help text for every generated flag")
+                .bind(values[i]);
+    }
+    auto cli = builder.build();
+
+    const auto& schema = cli.schema();
+    EXPECT_EQ(schema.option_at(0).desc, schema.option_at(99).desc);
+    EXPECT_EQ(schema.text(schema.option_at(42).desc),
+              "Shared help text for every generated flag");
+    EXPECT_EQ(schema.option_name(42), "--flag-42");
+    EXPECT_TRUE(schema.option_at(42).abbr.empty());
+}
@@ -0,0 +1,216 @@
+#include "mcli/mcli.hpp"
+#include "utils/args_builder.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using mcli::define;
+using mcli::detail::utils::g_tracer;
+using mcli::detail::utils::tracer;
+using test::utils::make_argv;
+
+namespace
+{
+
+std::string dump_trace()
+{
+    std::FILE* file = std::tmpfile();
+    g_tracer.dump(file);
+    std::rewind(file);
+
+    std::string text;
+    for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file))
+    {
+        text.push_back(static_cast<char>(c));
+    }
+    std::fclose(file);
+    return text;
+}
+
+std::size_t count_events(const std::string& trace)
+{
+    std::size_t count = 0;
+    for (auto pos = trace.find("\"ph\""); pos != std::string::npos;
+         pos = trace.find("\"ph\"", pos + 1))
+    {
+        ++count;
+    }
+    return count;
+}
+
+bool parse_verbose(std::initializer_list<std::string> args,
+                   bool detect_early = false)
+{
+    bool verbose = false;
+    const auto [argc, argv] = make_argv(args);
+    if (detect_early)
+    {
+        mcli::trace_from_args(argc, argv);
+    }
+
+    // clang-format off
+    auto cli = define()
+        .flag()
+            .name("--verbose")
+            .help("Enable verbose logging")
+            .bind(verbose)
+        .build();
+    // clang-format on
+
+    return static_cast<bool>(cli.parse(argc, argv));
+}
+
+}  // namespace
+
+TEST(Trace, RecordsNothingWhenOff)
+{
+    g_tracer.reset();
+
+    ASSERT_TRUE(parse_verbose({"app", "--verbose"}));
+
+    EXPECT_EQ(count_events(dump_trace()), 0U);
+}
+
+TEST(Trace, RecordsSetupAndParsePhases)
+{
+    g_tracer.reset();
+    g_tracer.enable();
+
+    ASSERT_TRUE(parse_verbose({"app", "--verbose"}));
+
+    g_tracer.disable();
+    auto trace = dump_trace();
+    g_tracer.reset();
+
+    EXPECT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0U);
+    for (const char* name : {"mcli.define",
+                             "mcli.flag",
+                             "mcli.build",
+                             "mcli.build.index",
+                             "mcli.build.constraints",
+                             "mcli.parse",
+                             "mcli.parse.tokens",
+                             "mcli.parse.constraints"})
+    {
+        EXPECT_NE(trace.find(std::string{"\"name\":\""} + name + "\""),
+                  std::string::npos)
+                << name;
+    }
+}
+
+bool has_event(const std::string& trace, const char* name)
+{
+    return trace.find(std::string{"\"name\":\""} + name + "\"") !=
+           std::string::npos;
+}
+
+TEST(Trace, ReservedFlagTracesSetupViaTraceFromArgs)
+{
+    g_tracer.reset();
+
+    ASSERT_TRUE(parse_verbose({"app", "--mcli-trace=unused.json"}, true));
+    EXPECT_TRUE(g_tracer.enabled());
+
+    g_tracer.disable();
+    auto trace = dump_trace();
+    // reset() also clears the output path, so nothing is written at exit.
+    g_tracer.reset();
+
+    for (const char* name : {"mcli.define",
+                             "mcli.flag",
+                             "mcli.build",
+                             "mcli.parse",
+                             "mcli.parse.tokens",
+                             "mcli.parse.positionals"})
+    {
+        EXPECT_TRUE(has_event(trace, name)) << name;
+    }
+
+    EXPECT_FALSE(parse_verbose({"app", "--mcli-trace-x"}, true));
+    EXPECT_FALSE(g_tracer.enabled());
+}
+
+TEST(Trace, ReservedFlagInParseOnlyTracesLaterPhases)
+{
+    g_tracer.reset();
+
+    ASSERT_TRUE(parse_verbose({"app", "--mcli-trace=unused.json"}));
+    EXPECT_TRUE(g_tracer.enabled());
+
+    g_tracer.disable();
+    auto trace = dump_trace();
+    g_tracer.reset();
+
+    // Setup and the spans already open when the flag was met are missed.
+    EXPECT_FALSE(has_event(trace, "mcli.define"));
+    EXPECT_FALSE(has_event(trace, "mcli.build"));
+    EXPECT_FALSE(has_event(trace, "mcli.parse"));
+    EXPECT_TRUE(has_event(trace, "mcli.parse.positionals"));
+}
+
+TEST(Trace, RingBufferKeepsNewestEvents)
+{
+    g_tracer.reset();
+    g_tracer.enable();
+
+    for (std::size_t i = 0; i < tracer::capacity + 10; ++i)
+    {
+        g_tracer.record("event", tracer::now(), tracer::now());
+    }
+
+    auto trace = dump_trace();
+    g_tracer.reset();
+
+    EXPECT_EQ(count_events(trace), tracer::capacity);
+}
+
+TEST(Trace, DumpWhileRecording)
+{
+    g_tracer.reset();
+    g_tracer.enable();
+
+    std::atomic<bool> stop{false};
+    std::atomic<std::size_t> recorded{0};
+    std::vector<std::jthread> writers;
+    for (const char* name : {"writer.a", "writer.b"})
+    {
+        writers.emplace_back(
+                [&stop, &recorded, name]
+                {
+                    while (!stop.load(std::memory_order_relaxed))
+                    {
+                        g_tracer.record(name, tracer::now(), tracer::now());
+                        recorded.fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+    }
+
+    // Dump until the writers have wrapped the ring a few times.
+    for (int round = 0;
+         round < 20 ||
+         recorded.load(std::memory_order_relaxed) < 4 * tracer::capacity;
+         ++round)
+    {
+        std::this_thread::yield();
+        auto trace = dump_trace();
+        EXPECT_LE(count_events(trace), tracer::capacity);
+        EXPECT_EQ(trace.find("\"name\":\"(null)\""), std::string::npos);
+        EXPECT_NE(trace.find("\"displayTimeUnit\""), std::string::npos);
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    writers.clear();
+    auto trace = dump_trace();
+    g_tracer.reset();
+
+    // A writer preempted between claiming and filling a slot may land on
+    // top of a newer event, which is then skipped: at most one per writer.
+    EXPECT_GE(count_events(trace), tracer::capacity - 2);
+    EXPECT_TRUE(has_event(trace, "writer.a") || has_event(trace, "writer.b"));
+}
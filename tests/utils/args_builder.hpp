@@ -1,49 +1,135 @@
 #ifndef ARGS_BUILDER_HPP_
 #define ARGS_BUILDER_HPP_
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace test::utils
 {
 
 /**
- * @brief Build argc/argv from a vector of strings.
+ * @brief Owning argc/argv pair.
  *
- * The first element should be the program name (like argv[0]).
- * The returned argv is null-terminated (argv[argc] == nullptr).
+ * Each instance owns its strings and pointer array, so argvs built on
+ * different threads never share storage. argv stays valid for the
+ * lifetime of the object (moves keep it valid too) and is
+ * null-terminated (argv[argc] == nullptr).
  *
- * NOTE: This helper owns its internal storage in a static variable so
- * the returned argv pointers remain valid until the next call.
- * It's intended for simple, single-threaded test usage.
+ * Supports structured bindings: `const auto [argc, argv] = make_argv(...)`
+ * keeps the storage alive until the end of the enclosing scope.
  */
-inline std::tuple<int, char**> make_argv(std::vector<std::string> args)
+class argv_builder
 {
-    // Static storage to keep strings and pointer array alive.
-    // Each call overwrites the previous contents.
-    static std::vector<std::string> storage;
-    static std::vector<char*> pointers;
+public:
+    argv_builder() = default;
+
+    explicit argv_builder(std::vector<std::string> args)
+        : m_storage{std::move(args)}
+    {
+        rebuild();
+    }
 
-    storage = std::move(args);
+    argv_builder(const argv_builder& other) : m_storage{other.m_storage}
+    {
+        rebuild();
+    }
+
+    argv_builder& operator=(const argv_builder& other)
+    {
+        if (this != &other)
+        {
+            m_storage = other.m_storage;
+            rebuild();
+        }
+        return *this;
+    }
+
+    // Moving the vectors keeps every string (and so every pointer) in
+    // place.
+    argv_builder(argv_builder&&) noexcept = default;
+    argv_builder& operator=(argv_builder&&) noexcept = default;
+
+    argv_builder& add(std::string_view arg)
+    {
+        m_storage.emplace_back(arg);
+        rebuild();
+        return *this;
+    }
+
+    [[nodiscard]] int argc() const noexcept
+    {
+        return static_cast<int>(m_storage.size());
+    }
 
-    pointers.clear();
-    pointers.reserve(storage.size() + 1);
+    // The parser takes char** like main(); the strings are never written.
+    [[nodiscard]] char** argv() const noexcept
+    {
+        return m_pointers.data();
+    }
 
-    for (auto& argument : storage)
+    template <std::size_t I>
+    [[nodiscard]] auto get() const noexcept
     {
-        pointers.push_back(argument.data());
+        if constexpr (I == 0)
+        {
+            return argc();
+        }
+        else
+        {
+            return argv();
+        }
     }
 
-    // POSIX: argv[argc] is a null pointer.
-    pointers.push_back(nullptr);
+private:
+    void rebuild()
+    {
+        m_pointers.clear();
+        m_pointers.reserve(m_storage.size() + 1);
+        for (auto& argument : m_storage)
+        {
+            m_pointers.push_back(argument.data());
+        }
+
+        // POSIX: argv[argc] is a null pointer.
+        m_pointers.push_back(nullptr);
+    }
 
-    const int argc = static_cast<int>(storage.size());
-    char** argv = pointers.data();
+    std::vector<std::string> m_storage;
+    mutable std::vector<char*> m_pointers{nullptr};
+};
 
-    return {argc, argv};
+/**
+ * @brief Build argc/argv from a vector of strings.
+ *
+ * The first element should be the program name (like argv[0]).
+ */
+inline argv_builder make_argv(std::vector<std::string> args)
+{
+    return argv_builder{std::move(args)};
 }
 
 }  // namespace test::utils
 
-#endif  // ARGS_BUILDER_HPP_
\ No newline at end of file
+template <>
+struct std::tuple_size<test::utils::argv_builder>
+    : std::integral_constant<std::size_t, 2>
+{
+};
+
+template <>
+struct std::tuple_element<0, test::utils::argv_builder>
+{
+    using type = int;
+};
+
+template <>
+struct std::tuple_element<1, test::utils::argv_builder>
+{
+    using type = char**;
+};
+
+#endif  // ARGS_BUILDER_HPP_